@@ -66,13 +66,7 @@ inline bool UniformBoolean(double p){
 
 inline std::vector<int> to_vector(const BitBoardN& bbn){
 	vector<int> res;
-
-	int v=EMPTY_ELEM;
-	while(1){
-		if((v=bbn.next_bit(v))==EMPTY_ELEM)
-			break;
-		res.push_back(v);
-	}
+	bbn.to_vector(res);
 return res;
 }
 
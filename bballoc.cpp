@@ -0,0 +1,153 @@
+// bballoc.cpp: implementation of the allocation policies for bitblocks
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "bballoc.h"
+#include "tables.h"
+#include <cstdlib>
+
+#ifdef _WIN32
+	#include <malloc.h>										//windows specific
+#else
+	#include <sys/mman.h>									//madvise
+#endif
+
+BBAlloc* BBAlloc::m_default=NULL;
+
+BBAlloc* BBAlloc::get_default(){
+	return (m_default)? m_default : &BBAlignedAlloc::instance();
+}
+
+void BBAlloc::set_default(BBAlloc* alloc){
+	m_default=alloc;
+}
+
+//////////////////////////
+//
+// BBAlignedAlloc
+//
+//////////////////////////
+
+BBAlignedAlloc& BBAlignedAlloc::instance(){
+	static BBAlignedAlloc alloc;						//available during static initialization
+	return alloc;
+}
+
+void* BBAlignedAlloc::aligned_malloc(size_t bytes, size_t align){
+#ifdef _WIN32
+	return _aligned_malloc(bytes, align);
+#else
+	void* p=NULL;
+	if(posix_memalign(&p, align, bytes)) return NULL;
+	return p;
+#endif
+}
+
+void BBAlignedAlloc::aligned_free(void* p){
+#ifdef _WIN32
+	_aligned_free(p);
+#else
+	free(p);
+#endif
+}
+
+BITBOARD* BBAlignedAlloc::allocate(size_t nBB){
+///////////////////
+// size is rounded up to whole alignment units so that the last bitblock never splits a cache line
+
+	size_t bytes=sizeof(BITBOARD)*(nBB>0? nBB : 1);
+	bytes=((bytes+m_align-1)/m_align)*m_align;
+	return (BITBOARD*)aligned_malloc(bytes, m_align);
+}
+
+void BBAlignedAlloc::deallocate(BITBOARD* p, size_t nBB){
+	aligned_free(p);
+}
+
+//////////////////////////
+//
+// BBNullAlloc
+//
+//////////////////////////
+
+BBNullAlloc& BBNullAlloc::instance(){
+	static BBNullAlloc alloc;
+	return alloc;
+}
+
+//////////////////////////
+//
+// BBHugePageAlloc
+//
+//////////////////////////
+
+BBHugePageAlloc& BBHugePageAlloc::instance(){
+	static BBHugePageAlloc alloc;
+	return alloc;
+}
+
+BITBOARD* BBHugePageAlloc::allocate(size_t nBB){
+	size_t bytes=sizeof(BITBOARD)*(nBB>0? nBB : 1);
+	if(bytes<m_threshold) 
+		return BBAlignedAlloc::allocate(nBB);
+
+	bytes=((bytes+HUGE_PAGE_SIZE-1)/HUGE_PAGE_SIZE)*HUGE_PAGE_SIZE;
+	void* p=aligned_malloc(bytes, HUGE_PAGE_SIZE);
+
+#ifdef MADV_HUGEPAGE
+	if(p) madvise(p, bytes, MADV_HUGEPAGE);				//transparent huge pages (hint only)
+#endif
+
+return (BITBOARD*)p;
+}
+
+void BBHugePageAlloc::deallocate(BITBOARD* p, size_t nBB){
+	aligned_free(p);									//both paths use the aligned primitives
+}
+
+//////////////////////////
+//
+// BBArena
+//
+//////////////////////////
+
+BBArena::BBArena(size_t bytes, size_t align):BBAlignedAlloc(align), m_top(0), m_nfallback(0){
+	m_size=((bytes+m_align-1)/m_align)*m_align;
+	m_slab=(char*)aligned_malloc(m_size? m_size : m_align, m_align);
+	if(!m_slab){
+		m_size=0;											//every request will fall back
+	}
+}
+
+BBArena::~BBArena(){
+	aligned_free(m_slab);
+}
+
+size_t BBArena::bytes_for(int popsize, int n, size_t align){
+	size_t bytes=sizeof(BITBOARD)*(INDEX_1TO1(popsize)>0? INDEX_1TO1(popsize) : 1);
+	return n*(((bytes+align-1)/align)*align);
+}
+
+BITBOARD* BBArena::allocate(size_t nBB){
+///////////////////
+// pointer bump, size rounded up to whole alignment units as in BBAlignedAlloc
+
+	size_t bytes=sizeof(BITBOARD)*(nBB>0? nBB : 1);
+	bytes=((bytes+m_align-1)/m_align)*m_align;
+	if(bytes>m_size-m_top){
+		m_nfallback++;
+		return BBAlignedAlloc::allocate(nBB);
+	}
+
+	BITBOARD* p=(BITBOARD*)(m_slab+m_top);
+	m_top+=bytes;
+return p;
+}
+
+void BBArena::deallocate(BITBOARD* p, size_t nBB){
+///////////////////
+// storage in the slab is reclaimed by release()/reset()
+
+	if(p && !owns(p))
+		BBAlignedAlloc::deallocate(p, nBB);
+}
@@ -0,0 +1,174 @@
+/*  
+ * bballoc.h file from the BITSCAN library, a C++ library for bit set
+ * optimization. BITSCAN has been used to implement BBMC, a very
+ * succesful bit-parallel algorithm for exact maximum clique. 
+ * (see license file for references)
+ *
+ * Copyright (C)
+ * Author: Pablo San Segundo
+ * Intelligent Control Research Group (CSIC-UPM) 
+ *
+ * Permission to use, modify and distribute this software is
+ * granted provided that this copyright notice appears in all 
+ * copies, in source code or in binaries. For precise terms 
+ * see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any 
+ * kind, express or implied, and with no claim as to its
+ * suitability for any purpose.
+ *
+ */
+
+#ifndef __BB_ALLOC_H__
+#define __BB_ALLOC_H__
+
+#include "bbtypes.h"
+#include "config.h"
+#include <cstddef>
+
+/////////////////////////////////
+//
+// class BBAlloc
+// (allocation policy for the bitblocks of dense bit strings)
+//
+// Every bit string keeps the allocator which reserved its bitblocks so that
+// deallocation always matches. The default allocator aligns to _MEM_ALIGNMENT (config.h)
+//
+///////////////////////////////////
+
+class BBAlloc{
+public:
+	virtual ~BBAlloc				(){}
+	virtual BITBOARD* allocate		(size_t nBB)=0;							//storage for nBB bitblocks (NULL if it fails)
+	virtual void deallocate			(BITBOARD* p, size_t nBB)=0;				//nBB is the size requested on allocation
+
+	static BBAlloc* get_default		();
+	static void set_default			(BBAlloc* alloc);						//NULL restores the aligned allocator (not thread safe)
+
+private:
+	static BBAlloc* m_default;
+};
+
+/////////////////////////////////
+//
+// class BBAlignedAlloc
+// (bitblocks aligned to cache lines, size rounded up to whole cache lines)
+//
+///////////////////////////////////
+
+class BBAlignedAlloc: public BBAlloc{
+public:
+explicit BBAlignedAlloc				(size_t align=_MEM_ALIGNMENT):m_align(align){}
+
+	BITBOARD* allocate				(size_t nBB);
+	void deallocate					(BITBOARD* p, size_t nBB);
+	size_t alignment				()						const {return m_align;}
+
+	static BBAlignedAlloc& instance	();										//default allocator of the library
+	
+protected:
+	static void* aligned_malloc		(size_t bytes, size_t align);
+	static void aligned_free		(void* p);
+
+	size_t m_align;
+};
+
+/////////////////////////////////
+//
+// class BBNullAlloc
+// (bitblocks owned elsewhere, e.g. read-only views of a memory mapped file)
+//
+// Allocation fails and deallocation is a no-op, so a bit string which keeps this allocator
+// never frees the storage it points to (and cannot grow)
+//
+///////////////////////////////////
+
+class BBNullAlloc: public BBAlloc{
+public:
+	BITBOARD* allocate				(size_t nBB)				{return NULL;}
+	void deallocate					(BITBOARD* p, size_t nBB)	{}
+
+	static BBNullAlloc& instance	();
+};
+
+/////////////////////////////////
+//
+// class BBHugePageAlloc
+// (huge bit strings are backed by huge pages of HUGE_PAGE_SIZE bytes)
+//
+// Allocations of at least threshold bytes are aligned and rounded to HUGE_PAGE_SIZE and 
+// advised as huge pages (transparent huge pages in Linux). Smaller ones are cache aligned.
+//
+///////////////////////////////////
+
+class BBHugePageAlloc: public BBAlignedAlloc{
+public:
+explicit BBHugePageAlloc			(size_t threshold=HUGE_PAGE_SIZE):m_threshold(threshold){}
+
+	BITBOARD* allocate				(size_t nBB);
+	void deallocate					(BITBOARD* p, size_t nBB);
+
+	static BBHugePageAlloc& instance();
+
+protected:
+	size_t m_threshold;
+};
+
+/////////////////////////////////
+//
+// class BBArena
+// (stack of cache aligned bitblocks carved from a single contiguous slab)
+//
+// Intended for the bit strings of a depth-indexed search stack: allocation is a pointer
+// bump and all the bit strings carved after a mark are released in O(1) on backtrack.
+// Deallocation of a single bit string is a no-op: storage is only reclaimed by release()/reset(),
+// so bit strings carved after a mark must not be used after the mark is released.
+// When the slab is exhausted requests fall back to the aligned allocator.
+// Not thread safe: use one arena per thread.
+//
+///////////////////////////////////
+
+class BBArena: public BBAlignedAlloc{
+public:
+	typedef size_t mark_t;
+
+	//RAII frame: releases everything carved during its lifetime
+	class scope{
+	public:
+	explicit scope(BBArena& arena):m_arena(arena), m_mark(arena.mark()){}
+		~scope()							{m_arena.release(m_mark);}
+	private:
+		scope(const scope&);
+		scope& operator=(const scope&);
+		BBArena& m_arena;
+		mark_t m_mark;
+	};
+
+explicit BBArena					(size_t bytes, size_t align=_MEM_ALIGNMENT);
+	~BBArena						();
+
+	BITBOARD* allocate				(size_t nBB);
+	void deallocate					(BITBOARD* p, size_t nBB);
+
+	mark_t mark						()					const {return m_top;}
+	void release					(mark_t m)				  {if(m<m_top) m_top=m;}
+	void reset						()						  {m_top=0;}
+
+	bool owns						(const BITBOARD* p)	const {return ((const char*)p>=m_slab && (const char*)p<m_slab+m_size);}
+	size_t capacity					()					const {return m_size;}
+	size_t used						()					const {return m_top;}
+	int number_of_fallbacks			()					const {return m_nfallback;}
+	
+	static size_t bytes_for			(int popsize, int n, size_t align=_MEM_ALIGNMENT);		//slab size for n bit strings of popsize bits
+
+private:
+	BBArena(const BBArena&);
+	BBArena& operator=(const BBArena&);
+
+	char* m_slab;
+	size_t m_size;
+	size_t m_top;															//offset of the first free byte
+	int m_nfallback;														//allocations which did not fit in the slab
+};
+
+#endif
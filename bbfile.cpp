@@ -0,0 +1,269 @@
+// bbfile.cpp: implementation of the binary file format for collections of bit strings
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "bbfile.h"
+#include <iostream>
+#include <cstring>
+
+#ifdef _WIN32
+	#include <windows.h>									//windows specific
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+using namespace std;
+
+const char BBFileFormat::MAGIC[8]={'B','I','T','S','C','A','N','\0'};
+
+//////////////////////////////////////////////////////////////////////
+// BBFileWriter
+//////////////////////////////////////////////////////////////////////
+
+int BBFileWriter::open(const char* filename, int popsize, BBFileFormat::kind_t kind){
+////////////////
+// the header is written as a placeholder and completed on close
+
+	if(m_f) close();
+	if(!(m_f=fopen(filename, "wb"))){
+		cerr<<"cannot open file for writing: "<<filename<<endl;
+		return -1;
+	}
+	m_kind=kind;
+	m_popsize=popsize;
+	m_pos=0;
+	m_dir.clear();
+
+	BBFileFormat::header_t h;
+	memset(&h, 0, sizeof(h));
+return write(&h, sizeof(h));
+}
+
+int BBFileWriter::append(const BitBoardN& bbn){
+	if(!m_f || m_kind!=BBFileFormat::DENSE){
+		cerr<<"dense row appended to a file which is not open or not DENSE"<<endl;
+		return -1;
+	}
+	if(bbn.number_of_bitblocks()!=INDEX_1TO1(m_popsize)){
+		cerr<<"row size does not match the population size of the file: "<<m_popsize<<endl;
+		return -1;
+	}
+
+	BBFileFormat::row_t r;
+	r.offset=m_pos;
+	r.count=bbn.number_of_bitblocks();
+	if(write(bbn.get_bitstring(), r.count*sizeof(BITBOARD))==-1 || pad()==-1) return -1;
+	m_dir.push_back(r);
+return 0;
+}
+
+int BBFileWriter::append(const BitBoardS& bbs){
+	if(!m_f || m_kind!=BBFileFormat::SPARSE){
+		cerr<<"sparse row appended to a file which is not open or not SPARSE"<<endl;
+		return -1;
+	}
+
+	//bounds are checked before anything is written (the rows that follow keep their alignment)
+	for(BitBoardS::velem_cit it=bbs.begin(); it!=bbs.end(); ++it){
+		if(WMUL(it->index)>=m_popsize){
+			cerr<<"sparse row outside the population size of the file: "<<m_popsize<<endl;
+			return -1;
+		}
+	}
+
+	BBFileFormat::row_t r;
+	r.offset=m_pos;
+	r.count=bbs.number_of_bitblocks();
+	for(BitBoardS::velem_cit it=bbs.begin(); it!=bbs.end(); ++it){
+		BITBOARD pair[2]={(BITBOARD)it->index, it->bb};
+		if(write(pair, sizeof(pair))==-1) return -1;
+	}
+	if(pad()==-1) return -1;
+	m_dir.push_back(r);
+return 0;
+}
+
+int BBFileWriter::close(){
+////////////////
+// directory at the end, then the header is completed
+
+	if(!m_f) return -1;
+
+	BBFileFormat::header_t h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, BBFileFormat::MAGIC, sizeof(h.magic));
+	h.version=BB_FILE_VERSION;
+	h.kind=m_kind;
+	h.endian=BB_FILE_ENDIAN;
+	h.nrows=m_dir.size();
+	h.popsize=m_popsize;
+	h.dir_offset=m_pos;
+
+	int res=0;
+	if(!m_dir.empty() && write(&m_dir[0], m_dir.size()*sizeof(BBFileFormat::row_t))==-1) res=-1;
+	if(res==0 && (fseek(m_f, 0, SEEK_SET) || fwrite(&h, sizeof(h), 1, m_f)!=1)){
+		cerr<<"cannot write the header of the file"<<endl;
+		res=-1;
+	}
+	if(fclose(m_f)) res=-1;
+	m_f=NULL;
+	m_dir.clear();
+return res;
+}
+
+int BBFileWriter::write(const void* p, size_t bytes){
+	if(bytes && fwrite(p, bytes, 1, m_f)!=1){
+		cerr<<"error writing to file"<<endl;
+		return -1;
+	}
+	m_pos+=bytes;
+return 0;
+}
+
+int BBFileWriter::pad(){
+	static const char zeros[BB_FILE_ALIGN]={0};
+	size_t rem=m_pos%BB_FILE_ALIGN;
+return (rem)? write(zeros, BB_FILE_ALIGN-rem) : 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// BBFileView
+//////////////////////////////////////////////////////////////////////
+
+int BBFileView::open(const char* filename){
+	close();
+
+#ifdef _WIN32
+	HANDLE hf=CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(hf==INVALID_HANDLE_VALUE){
+		cerr<<"cannot open file: "<<filename<<endl;
+		return -1;
+	}
+	LARGE_INTEGER size;
+	HANDLE hm=NULL;
+	if(GetFileSizeEx(hf, &size) && size.QuadPart>0)
+		hm=CreateFileMappingA(hf, NULL, PAGE_READONLY, 0, 0, NULL);
+	void* p=(hm)? MapViewOfFile(hm, FILE_MAP_READ, 0, 0, 0) : NULL;
+	if(!p){
+		if(hm) CloseHandle(hm);
+		CloseHandle(hf);
+		cerr<<"cannot map file: "<<filename<<endl;
+		return -1;
+	}
+	m_file=hf;
+	m_mapping=hm;
+	m_size=(size_t)size.QuadPart;
+#else
+	int fd=::open(filename, O_RDONLY);
+	if(fd==-1){
+		cerr<<"cannot open file: "<<filename<<endl;
+		return -1;
+	}
+	struct stat st;
+	void* p=MAP_FAILED;
+	if(fstat(fd, &st)==0 && st.st_size>0)
+		p=mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);											//the mapping keeps the file
+	if(p==MAP_FAILED){
+		cerr<<"cannot map file: "<<filename<<endl;
+		return -1;
+	}
+	m_size=st.st_size;
+#endif
+
+	m_map=(const char*)p;
+	if(validate()==-1){
+		cerr<<"not a valid bit string file: "<<filename<<endl;
+		close();
+		return -1;
+	}
+return 0;
+}
+
+int BBFileView::validate(){
+////////////////
+// header, directory and row bounds (the rows are not read)
+
+	if(m_size<sizeof(BBFileFormat::header_t)) return -1;
+	m_header=(const BBFileFormat::header_t*)m_map;
+	if(memcmp(m_header->magic, BBFileFormat::MAGIC, sizeof(m_header->magic)) ||
+		m_header->version>BB_FILE_VERSION || m_header->endian!=BB_FILE_ENDIAN ||
+		m_header->kind>BBFileFormat::SPARSE)
+		return -1;
+
+	const BITBOARD nrows=m_header->nrows;
+	if(m_header->dir_offset>m_size || m_header->dir_offset%sizeof(BITBOARD) ||
+		nrows*sizeof(BBFileFormat::row_t)>m_size-m_header->dir_offset) return -1;
+	m_dir=(const BBFileFormat::row_t*)(m_map+m_header->dir_offset);
+
+	const BITBOARD elem_bytes=(m_header->kind==BBFileFormat::DENSE)? sizeof(BITBOARD) : 2*sizeof(BITBOARD);
+	for(BITBOARD i=0; i<nrows; i++){
+		const BBFileFormat::row_t& r=m_dir[i];
+		if(r.offset>m_size || r.count>(m_size-r.offset)/elem_bytes || r.offset%sizeof(BITBOARD)) return -1;
+		if(m_header->kind==BBFileFormat::DENSE && r.count!=INDEX_1TO1(m_header->popsize)) return -1;
+	}
+
+	//in place views of the dense rows
+	if(m_header->kind==BBFileFormat::DENSE){
+		m_rows.reserve(nrows);
+		for(BITBOARD i=0; i<nrows; i++)
+			m_rows.push_back(BBIntrinView((const BITBOARD*)(m_map+m_dir[i].offset), (int)m_dir[i].count));
+	}
+return 0;
+}
+
+void BBFileView::close(){
+	m_rows.clear();
+	if(m_map){
+#ifdef _WIN32
+		UnmapViewOfFile(m_map);
+		CloseHandle((HANDLE)m_mapping);
+		CloseHandle((HANDLE)m_file);
+#else
+		munmap((void*)m_map, m_size);
+#endif
+	}
+	m_map=NULL;
+	m_size=0;
+	m_header=NULL;
+	m_dir=NULL;
+	m_file=NULL;
+	m_mapping=NULL;
+}
+
+int BBFileView::load_row(int i, BitBoardS& bbs) const{
+	if(!m_map || kind()!=BBFileFormat::SPARSE || i<0 || i>=number_of_rows()){
+		cerr<<"bad sparse row: "<<i<<endl;
+		return -1;
+	}
+
+	const BITBOARD* pairs=(const BITBOARD*)(m_map+m_dir[i].offset);
+	const int n=m_dir[i].count;
+
+	//indexes must be strictly increasing and inside the population
+	const BITBOARD nBB=INDEX_1TO1(m_header->popsize);
+	for(int j=0; j<n; j++){
+		if(pairs[2*j]>=nBB || (j>0 && pairs[2*j]<=pairs[2*(j-1)])){
+			cerr<<"corrupt sparse row: "<<i<<endl;
+			return -1;
+		}
+	}
+
+	bbs.init(m_header->popsize);
+	bbs.m_aBB.reserve(n);
+	for(int j=0; j<n; j++)
+		bbs.m_aBB.push_back(BitBoardS::elem((int)pairs[2*j], pairs[2*j+1]));
+return 0;
+}
+
+int BBFileView::load_row(int i, BitBoardN& bbn) const{
+	if(!m_map || kind()!=BBFileFormat::DENSE || i<0 || i>=number_of_rows()){
+		cerr<<"bad dense row: "<<i<<endl;
+		return -1;
+	}
+	bbn=m_rows[i];
+return 0;
+}
@@ -0,0 +1,151 @@
+/*
+ * bbfile.h file from the BITSCAN library, a C++ library for bit set
+ * optimization. BITSCAN has been used to implement BBMC, a very
+ * succesful bit-parallel algorithm for exact maximum clique.
+ * (see license file for references)
+ *
+ * Copyright (C)
+ * Author: Pablo San Segundo
+ * Intelligent Control Research Group (CSIC-UPM)
+ *
+ * Permission to use, modify and distribute this software is
+ * granted provided that this copyright notice appears in all
+ * copies, in source code or in binaries. For precise terms
+ * see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any
+ * kind, express or implied, and with no claim as to its
+ * suitability for any purpose.
+ *
+ */
+
+#ifndef __BB_FILE_H__
+#define __BB_FILE_H__
+
+#include "bbintrinsic.h"
+#include "bitboards.h"
+#include "bballoc.h"
+#include <cstdio>
+#include <vector>
+
+using namespace std;
+
+/////////////////////////////////
+//
+// Binary file format for collections of bit strings (e.g. the rows of an adjacency matrix)
+//
+// [header: 64 bytes] [row 0] [row 1] ... [directory: one row_t per row]
+//
+// All the rows have the same population size. Rows start at multiples of BB_FILE_ALIGN bytes:
+//	DENSE rows	: the bitblocks of the row
+//	SPARSE rows	: (block index, bitblock) pairs of 2x64 bits, sorted by block index
+// Values are stored in the byte order of the writer (checked by the reader through header_t::endian)
+//
+///////////////////////////////////
+
+#define BB_FILE_VERSION		1
+#define BB_FILE_ALIGN		64											//alignment of the rows in the file (one cache line)
+#define BB_FILE_ENDIAN		0x01020304
+
+struct BBFileFormat{
+	enum kind_t		{DENSE=0, SPARSE=1};
+
+	struct header_t{
+		char magic[8];													//"BITSCAN"
+		U32 version;
+		U32 kind;
+		U32 endian;														//BB_FILE_ENDIAN in the byte order of the writer
+		U32 nrows;
+		U32 popsize;													//bits per row
+		U32 reserved;
+		BITBOARD dir_offset;											//offset of the directory from the start of the file
+		char pad[24];
+	};
+
+	struct row_t{
+		BITBOARD offset;												//from the start of the file
+		BITBOARD count;													//DENSE: bitblocks, SPARSE: pairs
+	};
+
+	static const char MAGIC[8];
+};
+
+/////////////////////////////////
+//
+// class BBFileWriter
+// (writes rows one at a time, the header and the directory are completed on close)
+//
+///////////////////////////////////
+
+class BBFileWriter{
+public:
+	BBFileWriter					():m_f(NULL), m_kind(BBFileFormat::DENSE), m_popsize(0), m_pos(0){}
+	~BBFileWriter					()	{if(m_f) close();}
+
+	int open						(const char* filename, int popsize, BBFileFormat::kind_t kind=BBFileFormat::DENSE);
+	int append						(const BitBoardN& );								//DENSE files
+	int append						(const BitBoardS& );								//SPARSE files
+	int close						();													//RETURNS -1 if the file could not be completed
+	int number_of_rows				()				const	{return m_dir.size();}
+
+private:
+	BBFileWriter(const BBFileWriter&);
+	BBFileWriter& operator=(const BBFileWriter&);
+
+	int write						(const void* p, size_t bytes);
+	int pad							();													//up to the next BB_FILE_ALIGN boundary
+
+	FILE* m_f;
+	BBFileFormat::kind_t m_kind;
+	int m_popsize;
+	BITBOARD m_pos;																		//bytes written
+	vector<BBFileFormat::row_t> m_dir;
+};
+
+/////////////////////////////////
+//
+// class BBFileView
+// (read-only memory map of a file written by BBFileWriter)
+//
+// Opening a file only maps it and validates the header and the directory: DENSE rows are
+// exposed in place as const bit strings (zero copy). SPARSE rows are copied on demand into a
+// BitBoardS (a single pass over contiguous pairs).
+// The rows must not be used after the view is closed
+//
+///////////////////////////////////
+
+class BBFileView{
+public:
+	BBFileView						():m_map(NULL), m_size(0), m_header(NULL), m_dir(NULL), m_file(NULL), m_mapping(NULL){}
+explicit BBFileView					(const char* filename):m_map(NULL), m_size(0), m_header(NULL), m_dir(NULL), m_file(NULL), m_mapping(NULL){open(filename);}
+	~BBFileView						()	{close();}
+
+	int open						(const char* filename);								//RETURNS -1 if the file cannot be mapped or is not valid
+	void close						();
+	bool is_open					()				const	{return (m_map!=NULL);}
+
+	int number_of_rows				()				const	{return (m_header)? m_header->nrows : 0;}
+	int popsize						()				const	{return (m_header)? m_header->popsize : 0;}
+	int version						()				const	{return (m_header)? m_header->version : 0;}
+	BBFileFormat::kind_t kind		()				const	{return (BBFileFormat::kind_t)m_header->kind;}
+
+	const BBIntrin& row				(int i)			const	{return m_rows[i];}			//DENSE files (zero copy)
+	int load_row					(int i, BitBoardS& )	const;						//SPARSE files (copy)
+	int load_row					(int i, BitBoardN& )	const;						//DENSE files (copy)
+
+private:
+	BBFileView(const BBFileView&);
+	BBFileView& operator=(const BBFileView&);
+
+	int validate					();
+
+	const char* m_map;
+	size_t m_size;
+	const BBFileFormat::header_t* m_header;
+	const BBFileFormat::row_t* m_dir;
+	vector<BBIntrinView> m_rows;
+	void* m_file;																		//windows only: file and mapping handles
+	void* m_mapping;
+};
+
+#endif
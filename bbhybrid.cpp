@@ -0,0 +1,533 @@
+// bbhybrid.cpp: implementation of the BitBoardH class, sparse bit strings with hybrid (Roaring style) containers
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "bbhybrid.h"
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+
+static bool chunk_key_less(const BitBoardH::chunk_t& c, int key){return c.key<key;}
+
+//////////////////////////////////////////////////////////////////////
+// Containers
+//////////////////////////////////////////////////////////////////////
+
+int BitBoardH::chunk_t::set_bit(int v){
+	switch(type){
+	case ARRAY:
+		{
+			vector<U16>::iterator it=lower_bound(val.begin()+head, val.end(), (U16)v);
+			if(it!=val.end() && *it==v) return 0;
+			if(it==val.begin()+head && head>0)
+				val[--head]=(U16)v;										//reuses an erased slot
+			else
+				val.insert(it, (U16)v);
+			if(++card>ARRAY_MAX) to_bitmap();
+		}
+		break;
+	case BITMAP:
+		if(bb[WDIV(v)] & Tables::mask[WMOD(v)]) return 0;
+		bb[WDIV(v)]|=Tables::mask[WMOD(v)];
+		card++;
+		break;
+	case RUN:
+		{
+			//first run with last>=v
+			int nRuns=val.size()/2, i=0, hi=nRuns;
+			while(i<hi){
+				int mid=(i+hi)/2;
+				if(val[2*mid+1]<v) i=mid+1; else hi=mid;
+			}
+			if(i<nRuns && val[2*i]<=v) return 0;
+
+			bool left=(i>0 && val[2*i-1]==v-1);
+			bool right=(i<nRuns && val[2*i]==v+1);
+			if(left && right){
+				val[2*i-1]=val[2*i+1];
+				val.erase(val.begin()+2*i, val.begin()+2*i+2);
+			}else if(left){
+				val[2*i-1]=v;
+			}else if(right){
+				val[2*i]=v;
+			}else{
+				U16 run[2]={(U16)v, (U16)v};
+				val.insert(val.begin()+2*i, run, run+2);
+			}
+			card++;
+			repair();
+		}
+		break;
+	}
+return 1;
+}
+
+int BitBoardH::chunk_t::erase_bit(int v, bool convert){
+	switch(type){
+	case ARRAY:
+		{
+			vector<U16>::iterator it=lower_bound(val.begin()+head, val.end(), (U16)v);
+			if(it==val.end() || *it!=v) return 0;
+			if(it==val.begin()+head)
+				head++;													//front (forward destructive scans), see compact()
+			else
+				val.erase(it);
+			card--;
+		}
+		break;
+	case BITMAP:
+		if(!(bb[WDIV(v)] & Tables::mask[WMOD(v)])) return 0;
+		bb[WDIV(v)]&=~Tables::mask[WMOD(v)];
+		card--;
+		if(convert) repair();
+		break;
+	case RUN:
+		{
+			//run which contains v
+			int nRuns=val.size()/2, i=0, hi=nRuns;
+			while(i<hi){
+				int mid=(i+hi)/2;
+				if(val[2*mid+1]<v) i=mid+1; else hi=mid;
+			}
+			if(i==nRuns || val[2*i]>v) return 0;
+
+			int start=val[2*i], last=val[2*i+1];
+			if(start==last){
+				val.erase(val.begin()+2*i, val.begin()+2*i+2);
+			}else if(v==start){
+				val[2*i]++;
+			}else if(v==last){
+				val[2*i+1]--;
+			}else{											//splits the run
+				U16 run[2]={(U16)(v+1), (U16)last};
+				val[2*i+1]=v-1;
+				val.insert(val.begin()+2*i+2, run, run+2);
+			}
+			card--;
+			if(convert) repair();
+		}
+		break;
+	}
+return 1;
+}
+
+void BitBoardH::chunk_t::set_bit(int lv, int hv){
+///////////////////
+// sets the closed range [lv, hv]
+
+	if(card==0 || (lv==0 && hv==CHUNK_SIZE-1)){					//a single run
+		type=RUN;
+		val.assign(2, 0);
+		head=0;
+		val[0]=lv; val[1]=hv;
+		vector<BITBOARD>().swap(bb);
+		card=hv-lv+1;
+		return;
+	}
+
+	to_bitmap();
+	int wl=WDIV(lv), wh=WDIV(hv);
+	if(wl==wh){
+		bb[wl]|=~Tables::mask_right[WMOD(lv)] & ~Tables::mask_left[WMOD(hv)];
+	}else{
+		bb[wl]|=~Tables::mask_right[WMOD(lv)];
+		for(int w=wl+1; w<wh; w++) bb[w]=ONE;
+		bb[wh]|=~Tables::mask_left[WMOD(hv)];
+	}
+
+	card=0;
+	for(int w=0; w<BITMAP_WORDS; w++)
+		card+=BitBoard::popc64(bb[w]);
+	optimize();
+}
+
+int BitBoardH::chunk_t::number_of_runs() const{
+	int nRuns=0;
+	switch(type){
+	case ARRAY:
+		for(int i=head; i<val.size(); i++)
+			if(i==head || val[i]!=val[i-1]+1) nRuns++;
+		break;
+	case BITMAP:
+		{
+			BITBOARD carry=0;												//msb of the previous bitblock
+			for(int w=0; w<BITMAP_WORDS; w++){
+				nRuns+=BitBoard::popc64(bb[w] & ~((bb[w]<<1) | carry));	//1-bits preceded by a 0-bit
+				carry=bb[w]>>(WORD_SIZE-1);
+			}
+		}
+		break;
+	case RUN:
+		nRuns=val.size()/2;
+		break;
+	}
+return nRuns;
+}
+
+size_t BitBoardH::chunk_t::bytes() const{
+	return val.capacity()*sizeof(U16)+bb.capacity()*sizeof(BITBOARD);
+}
+
+void BitBoardH::chunk_t::to_array(){
+	if(type==ARRAY) return;
+	vector<U16> vals;
+	vals.reserve(card);
+	if(type==BITMAP){
+		unsigned long posInBB;
+		for(int w=0; w<BITMAP_WORDS; w++){
+			BITBOARD b=bb[w];
+			while(_BitScanForward64(&posInBB, b)){
+				vals.push_back((U16)(posInBB+WMUL(w)));
+				b&=b-1;
+			}
+		}
+		vector<BITBOARD>().swap(bb);
+	}else{
+		for(int i=0; i<val.size(); i+=2)
+			for(int v=val[i]; v<=val[i+1]; v++)
+				vals.push_back((U16)v);
+	}
+	val.swap(vals);
+	head=0;
+	type=ARRAY;
+}
+
+void BitBoardH::chunk_t::to_bitmap(){
+	if(type==BITMAP) return;
+	bb.assign(BITMAP_WORDS, ZERO);
+	if(type==ARRAY){
+		for(int i=head; i<val.size(); i++)
+			bb[WDIV(val[i])]|=Tables::mask[WMOD(val[i])];
+	}else{
+		for(int i=0; i<val.size(); i+=2)
+			for(int v=val[i]; v<=val[i+1]; v++)
+				bb[WDIV(v)]|=Tables::mask[WMOD(v)];
+	}
+	vector<U16>().swap(val);
+	head=0;
+	type=BITMAP;
+}
+
+void BitBoardH::chunk_t::to_run(){
+	if(type==RUN) return;
+	vector<U16> runs;
+	int v=next(0);
+	while(v!=EMPTY_ELEM){
+		int last=v;
+		while(last+1<CHUNK_SIZE && is_bit(last+1)) last++;
+		runs.push_back((U16)v);
+		runs.push_back((U16)last);
+		v=(last+1<CHUNK_SIZE)? next(last+1) : EMPTY_ELEM;
+	}
+	val.swap(runs);
+	head=0;
+	vector<BITBOARD>().swap(bb);
+	type=RUN;
+}
+
+void BitBoardH::chunk_t::compact(){
+	if(head){
+		val.erase(val.begin(), val.begin()+head);
+		head=0;
+	}
+}
+
+void BitBoardH::chunk_t::optimize(){
+//////////////////////
+// converts to the container with the smallest footprint
+
+	compact();
+	size_t ab=card*sizeof(U16);
+	size_t bmb=BITMAP_WORDS*sizeof(BITBOARD);
+	size_t rb=2*number_of_runs()*sizeof(U16);
+
+	if(rb<ab && rb<bmb)		to_run();
+	else if(ab<=bmb)		to_array();
+	else					to_bitmap();
+	val.shrink_to_fit();
+}
+
+void BitBoardH::chunk_t::repair(){
+//////////////////////
+// restores the container invariants after an update:
+// ARRAY and BITMAP by population, RUN is abandoned if it is no longer the smallest
+
+	switch(type){
+	case ARRAY:
+		if(card>ARRAY_MAX) to_bitmap();
+		break;
+	case BITMAP:
+		if(card<=ARRAY_MAX) to_array();
+		break;
+	case RUN:
+		if(val.size()*sizeof(U16)>min(card*sizeof(U16), BITMAP_WORDS*sizeof(BITBOARD))){
+			(card<=ARRAY_MAX)? to_array() : to_bitmap();
+		}
+		break;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+int BitBoardH::init(int popsize){
+	clear();
+	m_MAXBIT=popsize;
+return 0;
+}
+
+void BitBoardH::clear(){
+	m_chunks.clear();
+	m_MAXBIT=EMPTY_ELEM;
+}
+
+int BitBoardH::find_pos(int key) const{
+	vchunk::const_iterator it=lower_bound(m_chunks.begin(), m_chunks.end(), key, chunk_key_less);
+	if(it!=m_chunks.end() && it->key==key)
+		return (it-m_chunks.begin());
+return EMPTY_ELEM;
+}
+
+size_t BitBoardH::memory_bytes() const{
+	size_t bytes=sizeof(BitBoardH)+m_chunks.capacity()*sizeof(chunk_t);
+	for(int i=0; i<m_chunks.size(); i++)
+		bytes+=m_chunks[i].bytes();
+return bytes;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Conversion to and from BitBoardS
+//////////////////////////////////////////////////////////////////////
+
+int BitBoardH::from_sparse(const BitBoardS& bbs){
+///////////////////
+// the bitblocks of each chunk are copied to an ARRAY or BITMAP container, which is then optimized
+
+	m_chunks.clear();
+	m_MAXBIT=(bbs.m_MAXBB==EMPTY_ELEM)? EMPTY_ELEM : WMUL(bbs.m_MAXBB);
+
+	const BitBoardS::velem& aBB=bbs.m_aBB;
+	int i=0;
+	while(i<aBB.size()){
+		int key=aBB[i].index/BITMAP_WORDS;
+		int j=i, card=0;
+		for(; j<aBB.size() && aBB[j].index/BITMAP_WORDS==key; j++)
+			card+=BitBoard::popc64(aBB[j].bb);
+
+		if(card){
+			m_chunks.push_back(chunk_t(key));
+			chunk_t& c=m_chunks.back();
+			c.card=card;
+			if(card<=ARRAY_MAX){
+				c.type=ARRAY;
+				c.val.reserve(card);
+				unsigned long posInBB;
+				for(int k=i; k<j; k++){
+					BITBOARD b=aBB[k].bb;
+					while(_BitScanForward64(&posInBB, b)){
+						c.val.push_back((U16)(posInBB+WMUL(aBB[k].index%BITMAP_WORDS)));
+						b&=b-1;
+					}
+				}
+			}else{
+				c.type=BITMAP;
+				c.bb.assign(BITMAP_WORDS, ZERO);
+				for(int k=i; k<j; k++)
+					c.bb[aBB[k].index%BITMAP_WORDS]=aBB[k].bb;
+			}
+			c.optimize();
+		}
+		i=j;
+	}
+return 0;
+}
+
+int BitBoardH::to_sparse(BitBoardS& bbs) const{
+	if(m_MAXBIT!=EMPTY_ELEM)
+		bbs.init(m_MAXBIT);
+	else
+		bbs.init((m_chunks.empty())? 0 : (m_chunks.back().key+1)*CHUNK_SIZE);
+
+	BitBoardS::velem& aBB=bbs.m_aBB;
+	for(int i=0; i<m_chunks.size(); i++){
+		const chunk_t& c=m_chunks[i];
+		const int first_block=c.key*BITMAP_WORDS;
+		if(c.type==BITMAP){
+			for(int w=0; w<BITMAP_WORDS; w++)
+				if(c.bb[w]) aBB.push_back(BitBoardS::elem(first_block+w, c.bb[w]));
+		}else{
+			for(int v=(c.card)? c.next(0) : EMPTY_ELEM; v!=EMPTY_ELEM; v=(v+1<CHUNK_SIZE)? c.next(v+1) : EMPTY_ELEM){
+				int block=first_block+WDIV(v);
+				if(aBB.empty() || aBB.back().index!=block)
+					aBB.push_back(BitBoardS::elem(block, ZERO));
+				aBB.back().bb|=Tables::mask[WMOD(v)];
+			}
+		}
+	}
+return 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Set/Delete bits
+//////////////////////////////////////////////////////////////////////
+
+int BitBoardH::set_bit(int nbit){
+	if(nbit<0 || (m_MAXBIT!=EMPTY_ELEM && nbit>=m_MAXBIT)){
+		cerr<<"bit outside population limit: "<<nbit<<endl;
+		return -1;
+	}
+
+	int key=nbit>>CHUNK_BITS;
+	vchunk::iterator it=lower_bound(m_chunks.begin(), m_chunks.end(), key, chunk_key_less);
+	if(it==m_chunks.end() || it->key!=key)
+		it=m_chunks.insert(it, chunk_t(key));
+	it->set_bit(nbit&(CHUNK_SIZE-1));
+return 0;
+}
+
+int BitBoardH::set_bit(int lbit, int rbit){
+///////////////////
+// sets the bits in the CLOSED range [lbit, rbit]: new chunks are single RUN containers
+
+	if(lbit<0 || lbit>rbit || (m_MAXBIT!=EMPTY_ELEM && rbit>=m_MAXBIT)){
+		cerr<<"bad range: ["<<lbit<<", "<<rbit<<"]"<<endl;
+		return -1;
+	}
+
+	vchunk::iterator it=lower_bound(m_chunks.begin(), m_chunks.end(), lbit>>CHUNK_BITS, chunk_key_less);
+	for(int key=lbit>>CHUNK_BITS; key<=(rbit>>CHUNK_BITS); key++, it++){
+		if(it==m_chunks.end() || it->key!=key)
+			it=m_chunks.insert(it, chunk_t(key));
+		int lv=(key==(lbit>>CHUNK_BITS))? (lbit&(CHUNK_SIZE-1)) : 0;
+		int hv=(key==(rbit>>CHUNK_BITS))? (rbit&(CHUNK_SIZE-1)) : CHUNK_SIZE-1;
+		it->set_bit(lv, hv);
+	}
+return 0;
+}
+
+int BitBoardH::erase_bit(int nbit){
+	int pos=find_pos(nbit>>CHUNK_BITS);
+	if(pos!=EMPTY_ELEM){
+		m_chunks[pos].erase_bit(nbit&(CHUNK_SIZE-1));
+		if(m_chunks[pos].card==0)
+			m_chunks.erase(m_chunks.begin()+pos);
+	}
+return 0;
+}
+
+void BitBoardH::optimize(){
+///////////////////
+// removes empty chunks and converts the rest to their smallest container
+
+	int n=0;
+	for(int i=0; i<m_chunks.size(); i++){
+		if(m_chunks[i].card==0) continue;
+		if(n!=i) m_chunks[n]=std::move(m_chunks[i]);
+		m_chunks[n++].optimize();
+	}
+	m_chunks.resize(n, chunk_t());
+	m_chunks.shrink_to_fit();
+}
+
+//////////////////////////////////////////////////////////////////////
+// Boolean functions and popcount
+//////////////////////////////////////////////////////////////////////
+
+bool BitBoardH::is_empty() const{
+	for(int i=0; i<m_chunks.size(); i++)
+		if(m_chunks[i].card) return false;
+return true;
+}
+
+int BitBoardH::popcn64() const{
+	int pc=0;
+	for(int i=0; i<m_chunks.size(); i++)
+		pc+=m_chunks[i].card;
+return pc;
+}
+
+bool operator ==(const BitBoardH& lhs, const BitBoardH& rhs){
+	BBObject::scan_cursor sl, sr;
+	int r1=lhs.init_scan(sl, BBObject::NON_DESTRUCTIVE);
+	int r2=rhs.init_scan(sr, BBObject::NON_DESTRUCTIVE);
+	if(r1==EMPTY_ELEM || r2==EMPTY_ELEM)
+		return (lhs.is_empty() && rhs.is_empty());
+
+	while(true){
+		int v=lhs.next_bit(sl);
+		if(v!=rhs.next_bit(sr)) return false;
+		if(v==EMPTY_ELEM) break;
+	}
+return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Bit scanning
+//////////////////////////////////////////////////////////////////////
+
+int BitBoardH::init_scan(scan_types sct){
+	return init_scan(m_scan, sct);
+}
+
+int BitBoardH::init_scan(scan_cursor& sc, scan_types sct) const{
+//////////////
+// RETURNS EMPTY_ELEM if there are no chunks, -1 for a bad scan type
+
+	if(m_chunks.empty()) return EMPTY_ELEM;
+	switch(sct){
+	case NON_DESTRUCTIVE:
+		sc.bbi=0;
+		sc.pos=EMPTY_ELEM;
+		break;
+	case NON_DESTRUCTIVE_REVERSE:
+		sc.bbi=m_chunks.size()-1;
+		sc.pos=CHUNK_SIZE;
+		break;
+	case DESTRUCTIVE:
+		sc.bbi=0;
+		sc.pos=0;
+		break;
+	case DESTRUCTIVE_REVERSE:
+		sc.bbi=m_chunks.size()-1;
+		sc.pos=CHUNK_SIZE-1;
+		break;
+	default:
+		cerr<<"bad scan type"<<endl;
+		return -1;
+	}
+return 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// I/O
+//////////////////////////////////////////////////////////////////////
+
+void BitBoardH::print(ostream& o, bool show_pc) const{
+/////////////////////////
+// shows bit string as [bit1 bit2 bit3 ... <(pc)>]  (if empty: [ ]) (<pc> optional)
+
+	o<<"[";
+	scan_cursor sc;
+	if(init_scan(sc, NON_DESTRUCTIVE)!=EMPTY_ELEM){
+		for(int nBit=next_bit(sc); nBit!=EMPTY_ELEM; nBit=next_bit(sc))
+			o<<nBit<<" ";
+	}
+
+	if(show_pc){
+		int pc=popcn64();
+		if(pc) o<<"("<<pc<<")";
+	}
+	o<<"]";
+}
+
+void BitBoardH::to_vector(std::vector<int>& vl) const{
+	vl.clear();
+	vl.reserve(popcn64());
+	scan_cursor sc;
+	if(init_scan(sc, NON_DESTRUCTIVE)!=EMPTY_ELEM){
+		for(int nBit=next_bit(sc); nBit!=EMPTY_ELEM; nBit=next_bit(sc))
+			vl.push_back(nBit);
+	}
+}
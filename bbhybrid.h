@@ -0,0 +1,331 @@
+/*
+ * bbhybrid.h file from the BITSCAN library, a C++ library for bit set
+ * optimization. BITSCAN has been used to implement BBMC, a very
+ * succesful bit-parallel algorithm for exact maximum clique.
+ * (see license file for references)
+ *
+ * Copyright (C)
+ * Author: Pablo San Segundo
+ * Intelligent Control Research Group (CSIC-UPM)
+ *
+ * Permission to use, modify and distribute this software is
+ * granted provided that this copyright notice appears in all
+ * copies, in source code or in binaries. For precise terms
+ * see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any
+ * kind, express or implied, and with no claim as to its
+ * suitability for any purpose.
+ *
+ */
+
+#ifndef __BB_HYBRID_H__
+#define __BB_HYBRID_H__
+
+#include "bbobject.h"
+#include "bitboard.h"
+#include "bitboards.h"
+#include <vector>
+
+using namespace std;
+
+/////////////////////////////////
+//
+// class BitBoardH
+// (Manages sparse bit strings with hybrid containers, Roaring style)
+//
+// The population is split in chunks of 2^16 bits. Each non-empty chunk is stored in
+// the smallest of three containers:
+//	ARRAY	: sorted 16-bit values (up to ARRAY_MAX elements)
+//	BITMAP	: 1024 bitblocks
+//	RUN		: sorted closed intervals [start, last] of 16-bit values
+//
+// ARRAY and BITMAP containers are converted into each other as the population of the chunk
+// crosses ARRAY_MAX. RUN containers are created by range setting (set_bit(lbit, rbit)) and by
+// optimize(), which also removes the empty chunks left by destructive scans.
+// Values are removed from the front of an ARRAY container (forward destructive scans) by moving
+// an offset (head), so that emptying the container is O(card): optimize() compacts them.
+//
+// Conversion to and from BitBoardS is provided
+//
+///////////////////////////////////
+
+class BitBoardH: public BBObject{
+public:
+	enum cont_t		{ARRAY, BITMAP, RUN};											//types of containers
+
+	static const int CHUNK_BITS=16;
+	static const int CHUNK_SIZE=(1<<CHUNK_BITS);										//bits per chunk
+	static const int BITMAP_WORDS=CHUNK_SIZE/WORD_SIZE;									//bitblocks of a BITMAP container
+	static const int ARRAY_MAX=4096;													//maximum population of an ARRAY container
+
+	struct chunk_t{
+		chunk_t(int key=EMPTY_ELEM):key(key), type(ARRAY), card(0), head(0){}
+
+		int key;																		//chunk index (bits [key*CHUNK_SIZE, (key+1)*CHUNK_SIZE[)
+		cont_t type;
+		int card;																		//population of the chunk
+		vector<U16> val;																//ARRAY: values, RUN: [start, last] pairs
+		int head;																		//ARRAY: values are val[head, end[ (val[0, head[ were erased from the front, see compact())
+		vector<BITBOARD> bb;															//BITMAP
+
+		//values are 0 based, relative to the chunk
+inline	bool is_bit					(int v)			const;
+inline	int next					(int v)			const;						//smallest 1-bit >= v (EMPTY_ELEM if none)
+inline	int previous				(int v)			const;						//greatest 1-bit <= v (EMPTY_ELEM if none)
+		int set_bit					(int v);									//RETURNS 1 if the bit was not in the chunk, 0 otherwise
+		int erase_bit				(int v, bool convert=true);					//RETURNS 1 if the bit was in the chunk, 0 otherwise (convert: see repair())
+		void set_bit				(int lv, int hv);							//closed range
+
+		int number_of_runs			()				const;
+		size_t bytes				()				const;						//heap memory of the container
+		void to_array				();
+		void to_bitmap				();
+		void to_run					();
+		void compact				();											//removes the values before head
+		void optimize				();											//compacts and converts to the smallest container
+		void repair					();											//converts ARRAY/BITMAP by population and RUN if too fragmented
+	};
+
+	typedef vector<chunk_t> vchunk;
+	typedef scan_cursor scan_t;															//bbi: position of the chunk in the collection, pos: last value found in the chunk
+
+	BitBoardH						():m_MAXBIT(EMPTY_ELEM){}
+explicit BitBoardH					(int popsize /*1 based*/):m_MAXBIT(popsize){}
+explicit BitBoardH					(const BitBoardS& bbs)	{from_sparse(bbs);}
+virtual ~BitBoardH					(){}
+
+	int init						(int popsize);
+	void clear						();
+
+/////////////////////
+// setters and getters
+	int number_of_chunks			()						const {return m_chunks.size();}
+	const chunk_t& get_chunk		(int pos)				const {return m_chunks[pos];}		//position in the collection
+	int find_pos					(int key)				const;								//position of the chunk, EMPTY_ELEM if not found (O(log))
+	size_t memory_bytes				()						const;								//total memory including the containers
+
+/////////////////////
+// conversion to and from BitBoardS
+	int from_sparse					(const BitBoardS& );
+	int to_sparse					(BitBoardS& )			const;
+
+/////////////////////
+// Set/Delete Bits (nbit is always 0 based)
+	int set_bit						(int nbit);
+	int set_bit						(int lbit, int rbit);									//CLOSED range
+	int erase_bit					(int nbit);												//removes the chunk if it becomes empty
+	void erase_bit					()						{m_chunks.clear();}				//clears all bits
+	void optimize					();														//smallest containers, removes empty chunks
+
+/////////////////////
+// Boolean functions
+inline	bool is_bit					(int nbit)				const;
+	bool is_empty					()						const;
+
+/////////////////
+// Popcount
+	int popcn64						()						const;
+
+//////////////////////////////
+// Bitscanning (same interface as BBIntrinS)
+	int init_scan					(scan_types);
+inline	int next_bit				()						{return next_bit(m_scan);}
+inline	int next_bit_del			()						{return next_bit_del(m_scan);}
+inline	int previous_bit			()						{return previous_bit(m_scan);}
+inline	int previous_bit_del		()						{return previous_bit_del(m_scan);}
+
+	//scans with an external cursor (non destructive scans are const)
+	int init_scan					(scan_cursor&, scan_types)		const;
+inline	int next_bit				(scan_cursor&)					const;
+inline	int previous_bit			(scan_cursor&)					const;
+inline	int next_bit_del			(scan_cursor&);
+inline	int previous_bit_del		(scan_cursor&);
+
+/////////////////////
+// I/O
+virtual	void print					(ostream& = cout, bool show_pc = true) const;
+	void to_vector					(std::vector<int>& )	const;
+
+	friend bool operator ==			(const BitBoardH&, const BitBoardH&);						//same 1-bits (regardless of the containers)
+	friend bool operator !=			(const BitBoardH& lhs, const BitBoardH& rhs)	{return !(lhs==rhs);}
+
+////////////////////////
+// Member data
+public:
+	scan_t m_scan;
+protected:
+	vchunk m_chunks;													//sorted (by key) chunks
+	int m_MAXBIT;														//population size (EMPTY_ELEM: unbounded)
+};
+
+///////////////////////
+//
+// INLINE FUNCTIONS
+//
+////////////////////////
+
+inline bool BitBoardH::chunk_t::is_bit(int v) const{
+	switch(type){
+	case ARRAY:
+		return binary_search(val.begin()+head, val.end(), (U16)v);
+	case BITMAP:
+		return (bb[WDIV(v)] & Tables::mask[WMOD(v)]);
+	case RUN:
+		{
+			int r=previous(v);
+			return (r==v);
+		}
+	}
+return false;
+}
+
+inline int BitBoardH::chunk_t::next(int v) const{
+	switch(type){
+	case ARRAY:
+		{
+			vector<U16>::const_iterator it=lower_bound(val.begin()+head, val.end(), (U16)v);
+			return (it==val.end())? EMPTY_ELEM : *it;
+		}
+	case BITMAP:
+		{
+			unsigned long posInBB;
+			int w=WDIV(v);
+			if(_BitScanForward64(&posInBB, bb[w] & ~Tables::mask_right[WMOD(v)]))
+				return (posInBB+WMUL(w));
+			for(w++; w<BITMAP_WORDS; w++){
+				if(_BitScanForward64(&posInBB, bb[w]))
+					return (posInBB+WMUL(w));
+			}
+			return EMPTY_ELEM;
+		}
+	case RUN:
+		{
+			//first run with last>=v (runs are stored as [start, last] pairs)
+			int lo=0, hi=val.size()/2;
+			while(lo<hi){
+				int mid=(lo+hi)/2;
+				if(val[2*mid+1]<v) lo=mid+1; else hi=mid;
+			}
+			if(lo==val.size()/2) return EMPTY_ELEM;
+			return (val[2*lo]>v)? val[2*lo] : v;
+		}
+	}
+return EMPTY_ELEM;
+}
+
+inline int BitBoardH::chunk_t::previous(int v) const{
+	switch(type){
+	case ARRAY:
+		{
+			vector<U16>::const_iterator it=upper_bound(val.begin()+head, val.end(), (U16)v);
+			return (it==val.begin()+head)? EMPTY_ELEM : *(--it);
+		}
+	case BITMAP:
+		{
+			unsigned long posInBB;
+			int w=WDIV(v);
+			if(_BitScanReverse64(&posInBB, bb[w] & ~Tables::mask_left[WMOD(v)]))
+				return (posInBB+WMUL(w));
+			for(w--; w>=0; w--){
+				if(_BitScanReverse64(&posInBB, bb[w]))
+					return (posInBB+WMUL(w));
+			}
+			return EMPTY_ELEM;
+		}
+	case RUN:
+		{
+			//last run with start<=v
+			int lo=0, hi=val.size()/2;
+			while(lo<hi){
+				int mid=(lo+hi)/2;
+				if(val[2*mid]<=v) lo=mid+1; else hi=mid;
+			}
+			if(lo==0) return EMPTY_ELEM;
+			lo--;
+			return (val[2*lo+1]<v)? val[2*lo+1] : v;
+		}
+	}
+return EMPTY_ELEM;
+}
+
+inline bool BitBoardH::is_bit(int nbit) const{
+	int pos=find_pos(nbit>>CHUNK_BITS);
+	if(pos==EMPTY_ELEM) return false;
+return m_chunks[pos].is_bit(nbit&(CHUNK_SIZE-1));
+}
+
+inline int BitBoardH::next_bit(scan_cursor& sc) const{
+////////////////////////////
+// non destructive: sc.pos is the last value found in the chunk (EMPTY_ELEM at the start of a chunk)
+
+	const int nChunks=m_chunks.size();
+	while(sc.bbi<nChunks){
+		const chunk_t& c=m_chunks[sc.bbi];
+		int v=(sc.pos+1<CHUNK_SIZE)? c.next(sc.pos+1) : EMPTY_ELEM;
+		if(v!=EMPTY_ELEM){
+			sc.pos=v;
+			return ((c.key<<CHUNK_BITS)+v);
+		}
+		sc.bbi++;
+		sc.pos=EMPTY_ELEM;
+	}
+return EMPTY_ELEM;
+}
+
+inline int BitBoardH::previous_bit(scan_cursor& sc) const{
+////////////////////////////
+// non destructive: sc.pos is the last value found in the chunk (CHUNK_SIZE at the end of a chunk)
+
+	while(sc.bbi>=0){
+		const chunk_t& c=m_chunks[sc.bbi];
+		int v=(sc.pos>0)? c.previous(sc.pos-1) : EMPTY_ELEM;
+		if(v!=EMPTY_ELEM){
+			sc.pos=v;
+			return ((c.key<<CHUNK_BITS)+v);
+		}
+		sc.bbi--;
+		sc.pos=CHUNK_SIZE;
+	}
+return EMPTY_ELEM;
+}
+
+inline int BitBoardH::next_bit_del(scan_cursor& sc){
+////////////////////////////
+// destructive: sc.pos is a lower bound of the values left in the chunk
+// (chunks emptied by the scan are not removed, see optimize())
+
+	const int nChunks=m_chunks.size();
+	while(sc.bbi<nChunks){
+		chunk_t& c=m_chunks[sc.bbi];
+		int v=(c.card)? c.next(sc.pos) : EMPTY_ELEM;
+		if(v!=EMPTY_ELEM){
+			c.erase_bit(v, false);							//no container conversions during the scan
+			sc.pos=v;
+			return ((c.key<<CHUNK_BITS)+v);
+		}
+		sc.bbi++;
+		sc.pos=0;
+	}
+return EMPTY_ELEM;
+}
+
+inline int BitBoardH::previous_bit_del(scan_cursor& sc){
+////////////////////////////
+// destructive: sc.pos is an upper bound of the values left in the chunk
+
+	while(sc.bbi>=0){
+		chunk_t& c=m_chunks[sc.bbi];
+		int v=(c.card)? c.previous(sc.pos) : EMPTY_ELEM;
+		if(v!=EMPTY_ELEM){
+			c.erase_bit(v, false);
+			sc.pos=v;
+			return ((c.key<<CHUNK_BITS)+v);
+		}
+		sc.bbi--;
+		sc.pos=CHUNK_SIZE-1;
+	}
+return EMPTY_ELEM;
+}
+
+#endif
@@ -22,7 +22,9 @@
 #pragma once
 
 #include "bitboardn.h"	
+#include "bbscan.h"
 #include <vector>			//I/O
+#include <utility>			//std::move
 
 using namespace std;
 
@@ -35,20 +37,22 @@ using namespace std;
 ///////////////////////////////////
 
 class BBIntrin: public BitBoardN{
+	friend class BBIntrinScan;
 public:	
 
-	struct scan_t{																			//For bitscanning optimization
-		scan_t():bbi(EMPTY_ELEM), pos(MASK_LIM){}
-		int bbi;	//bitboard index 	
-		int pos;	//bit position for bitscan		
-	};
+	typedef scan_cursor scan_t;																//For bitscanning optimization
 		
 	 BBIntrin						(){};										
 explicit  BBIntrin				(int popsize /*1 based*/, bool reset=true):BitBoardN(popsize,reset){}	
+	 BBIntrin						(int popsize /*1 based*/, BBAlloc& alloc, bool reset=true):BitBoardN(popsize,alloc,reset){}
 	 BBIntrin						(const BBIntrin& bbN):BitBoardN(bbN){}
+	 BBIntrin						(BBIntrin&& bbN) noexcept:BitBoardN(std::move(bbN)){}
 	 BBIntrin						(const std::vector<int>& v): BitBoardN(v){}
 virtual ~BBIntrin					(){}
 
+	BBIntrin& operator =			(const BBIntrin& bbN)			{BitBoardN::operator=(bbN); m_scan=bbN.m_scan; return *this;}
+	BBIntrin& operator =			(BBIntrin&& bbN) noexcept		{BitBoardN::operator=(std::move(bbN)); m_scan=bbN.m_scan; return *this;}
+
 	 void set_bbindex				(int bbindex){m_scan.bbi=bbindex;}	
 	 void set_posbit				(int posbit){m_scan.pos=posbit;}	
  
@@ -87,6 +91,15 @@ virtual	inline int next_bit			(int &,  BBIntrin& );
 inline int previous_bit_del				(int& nBB);
 inline int previous_bit_del				(int& nBB,  BBIntrin& del ); 
 
+	//scans with an external cursor (non destructive scans are const: several threads may scan the same bit string)
+inline int init_scan					(scan_cursor&, scan_types)					const;
+inline int init_scan_from				(scan_cursor&, int from, scan_types)		const;
+inline int next_bit						(scan_cursor&)								const;
+inline int next_bit						(scan_cursor&, int& nBB)					const;
+inline int previous_bit					(scan_cursor&)								const;
+inline int next_bit_del					(scan_cursor&);
+inline int previous_bit_del				(scan_cursor&);
+
 /////////////////
 // Popcount
 #ifdef POPCOUNT_64
@@ -99,18 +112,85 @@ virtual	 inline int popcn64				(int nBit/*0 based*/)	const;
 	 scan_t m_scan;
 };
 
+/////////////////////////////////
+//
+// class BBIntrinScan
+// (scanning of a BBIntrin with static dispatch, see BBScan)
+//
+// A lightweight view which shares the scanning state of the bit string, so
+// it can be used interchangeably with the virtual interface
+//
+///////////////////////////////////
+
+class BBIntrinScan: public BBScan<BBIntrinScan>{
+	friend class BBScan<BBIntrinScan>;
+public:
+explicit BBIntrinScan					(BBIntrin& bb):m_bb(bb), m_scan(bb.m_scan){}
+	BBIntrinScan						(BBIntrin& bb, BBIntrin::scan_t& sc):m_bb(bb), m_scan(sc){}	//external cursor
+
+private:
+	BITBOARD* bitblocks					()	const	{return m_bb.m_aBB;}
+	int low_block						()	const	{return 0;}
+	int high_block						()	const	{return m_bb.m_nBB-1;}
+	BBIntrin::scan_t& scan_state		()			{return m_scan;}
+	int& cursor_low						()			{return m_scan.bbi;}
+	int& cursor_high					()			{return m_scan.bbi;}
+	void prepare_scan					()			{}
+
+	BBIntrin& m_bb;
+	BBIntrin::scan_t& m_scan;
+};
+
+/////////////////////////////////
+//
+// class BBIntrinView
+// (BBIntrin over bitblocks owned elsewhere: rows of a BitMatrix, mapped files etc.)
+//
+// Has the full API without copying the bitblocks (copies of a view own their bitblocks). 
+// The storage is never released (BBNullAlloc) and the size is fixed: assignment copies the bits
+// of a bit string of the same size (other sizes are rejected), moving into a view and resizing it
+// are not allowed
+//
+///////////////////////////////////
+
+class BBIntrinView: public BBIntrin{
+public:
+	BBIntrinView					(const BITBOARD* aBB, int nBB){
+										m_aBB=const_cast<BITBOARD*>(aBB);
+										m_nBB=nBB;
+										m_cap=nBB;
+										m_alloc=&BBNullAlloc::instance();
+									}
+	BBIntrinView					(const BBIntrinView& bbv):BBIntrin(bbv){}
+	BBIntrinView					(BBIntrinView&& bbv) noexcept:BBIntrin(std::move(bbv)){}		//same bitblocks (containers of views)
+
+	BBIntrinView& operator =		(const BBIntrinView& bbv)		{operator=((const BitBoardN&)bbv); return *this;}
+virtual	BitBoardN& operator =		(const BitBoardN& bbN);												//RETURNS *this unchanged if the sizes differ
+	BBIntrinView& operator =		(BBIntrinView&& )=delete;
+
+	void init						(int popsize, bool reset=true)=delete;
+	void init						(int popsize, const vector<int>& )=delete;
+	int  reserve					(int popsize)=delete;
+	int  resize						(int popsize)=delete;
+};
+
 ///////////////////////
 //
 // INLINE FUNCTIONS
 // 
 ////////////////////////
+
+inline BitBoardN& BBIntrinView::operator = (const BitBoardN& bbN){
+	if(this==&bbN) return *this;
+	if(bbN.number_of_bitblocks()!=m_nBB){
+		cerr<<"bit string of a different size assigned to a view: BBIntrinView"<<endl;
+		return *this;
+	}
+return BitBoardN::operator=(bbN);
+}
 #ifdef POPCOUNT_64
 inline int BBIntrin::popcn64() const{
-	BITBOARD pc=0;
-	for(int i=0; i<m_nBB; i++){
-		pc+=__popcnt64(m_aBB[i]);
-	}
-return pc;
+	return BBIntrinScan(const_cast<BBIntrin&>(*this)).popcn64();			//read only
 }
 
 
@@ -134,277 +214,83 @@ return pc;
 
 #endif
 
-inline int BBIntrin::next_bit(int &nBB_new)  {
 ////////////////////////////
-// Date:23/3/2012
-// BitScan not destructive
-// Version that use static data of the last bit position and the last table
-//
-// COMMENTS
-// 1-Require previous assignment BitBoardN::scan=0 and BBIntrin::scanv=MASK_LIM
-
-	unsigned long posInBB;
-			
-	//Search int the last table
-	if(_BitScanForward64(&posInBB, m_aBB[m_scan.bbi] & Tables::mask_left[m_scan.pos])){
-		m_scan.pos =posInBB;
-		nBB_new=m_scan.bbi;
-		return (posInBB + WMUL(m_scan.bbi));
-	}else{											//Not found in the last table. Search in the rest
-		for(int i=m_scan.bbi+1; i<m_nBB; i++){
-			if(_BitScanForward64(&posInBB,m_aBB[i])){
-				m_scan.bbi=i;
-				m_scan.pos=posInBB;
-				nBB_new=i;
-				return (posInBB+ WMUL(i));
-			}
-		}
-	}
-return EMPTY_ELEM;
+// The scanning hot path is implemented once in BBScan (static dispatch). The virtual
+// members below are thin adapters for polymorphic clients: tight loops should
+// scan through a BBIntrinScan directly
+
+inline int BBIntrin::next_bit(int &nBB_new)  {
+	return BBIntrinScan(*this).next_bit(nBB_new);
 }
 
 inline int BBIntrin::next_bit(int &nBB_new,  BBIntrin& bbN_del ) {
-////////////////////////////
-// Date:30/3/2012
-// BitScan not destructive
-// Version that use static data of the last bit position and the last table
-//
-// COMMENTS
-// 1-Require previous assignment BitBoardN::scan=0 and BitBoardN::scanv=MASK_LIM
-
-	unsigned long posInBB;
-			
-	//Search int the last table
-	if(_BitScanForward64(&posInBB, m_aBB[m_scan.bbi] & Tables::mask_left[m_scan.pos])){
-		m_scan.pos =posInBB;
-		nBB_new=m_scan.bbi;
-		bbN_del.m_aBB[m_scan.bbi]&=~Tables::mask[posInBB];
-		return (posInBB + WMUL(m_scan.bbi));
-	}else{											//Not found in the last table. Search in the rest
-		for(int i=m_scan.bbi+1; i<m_nBB; i++){
-			if(_BitScanForward64(&posInBB,m_aBB[i])){
-				m_scan.bbi=i;
-				m_scan.pos=posInBB;
-				nBB_new=i;
-				bbN_del.m_aBB[i]&=~Tables::mask[posInBB];
-				return (posInBB+ WMUL(i));
-			}
-		}
-	}
-return EMPTY_ELEM;
+	return BBIntrinScan(*this).next_bit(nBB_new, bbN_del);
 }
 
-
 inline int BBIntrin::msbn64() const{
-////////////////////////////
-//
-// Date: 30/3/12
-// Return the last bit
-// 
-// COMMENTS: New variable static scan which stores index of every BB
-
-	 unsigned long posInBB;
-
-	for(int i=m_nBB-1; i>=0; i--){
-		//Siempre me queda la duda mas de si es mas eficiente comparar con 0
-		if(_BitScanReverse64(&posInBB,m_aBB[i]))
-			return (posInBB+WMUL(i));
-	}
-	
-return EMPTY_ELEM;  
+	return BBIntrinScan(const_cast<BBIntrin&>(*this)).msbn64();				//read only
 }
-
 	
 inline int BBIntrin::lsbn64() const{
-	unsigned long posBB;
-	for(int i=0; i<m_nBB; i++){
-		if(_BitScanForward64(&posBB, m_aBB[i]))
-			return(posBB+ WMUL(i));	
-	}
-return EMPTY_ELEM;
+	return BBIntrinScan(const_cast<BBIntrin&>(*this)).lsbn64();				//read only
 }
 
-
-
 inline int BBIntrin::next_bit_del() {
-////////////////////////////
-//
-// Date: 23/3/12
-// BitScan with Delete (D- erase the bit scanned) and Intrinsic
-// 
-// COMMENTS: New variable static scan which stores index of every BB
-
-	 unsigned long posInBB;
-
-	for(int i=m_scan.bbi; i<m_nBB; i++)	{
-		if(_BitScanForward64(&posInBB,m_aBB[i])){
-			m_scan.bbi=i;
-			m_aBB[i]&=~Tables::mask[posInBB];			//Deletes the current bit before returning
-			return (posInBB+WMUL(i));
-		}
-	}
-	
-return EMPTY_ELEM;  
+	return BBIntrinScan(*this).next_bit_del();
 }
 
-
 inline int BBIntrin::next_bit_del(int& nBB) {
-//////////////
-// Also return the number of table
-	unsigned long posInBB;
-
-	for(int i=m_scan.bbi; i<m_nBB; i++)	{
-		if(_BitScanForward64(&posInBB,m_aBB[i])){
-			m_scan.bbi=i;
-			m_aBB[i]&=~Tables::mask[posInBB];			//Deleting before the return
-			nBB=i;
-			return (posInBB+WMUL(i));
-		}
-	}
-	
-return EMPTY_ELEM;  
+	return BBIntrinScan(*this).next_bit_del(nBB);
 }
 
 inline int BBIntrin::next_bit_del(int& nBB, BBIntrin& bbN_del) {
-//////////////
-// BitScan DI it also erase the returned bit of the table passed
-	unsigned long posInBB;
-
-	for(int i=m_scan.bbi; i<m_nBB; i++){
-		if(_BitScanForward64(&posInBB,m_aBB[i])){
-			m_scan.bbi=i;
-			m_aBB[i]&=~Tables::mask[posInBB];					//Deleting before the return
-			bbN_del.m_aBB[i]&=~Tables::mask[posInBB];
-			nBB=i;
-			return (posInBB+WMUL(i));
-		}
-	}
-	
-return EMPTY_ELEM;  
+	return BBIntrinScan(*this).next_bit_del(nBB, bbN_del);
 }
 
 inline int BBIntrin::next_bit() {
-////////////////////////////
-// Date:23/3/2012
-// BitScan not destructive
-// Version that use static data of the last bit position and the last table
-//
-// COMMENTS
-// 1-Require previous assignment m_scan_bbl=0 and m_scan.pos=MASK_LIM
-
-	unsigned long posInBB;
-			
-	//Search for next bit in the last block
-	if(_BitScanForward64(&posInBB, m_aBB[m_scan.bbi] & Tables::mask_left[m_scan.pos])){
-		m_scan.pos =posInBB;
-		return (posInBB + WMUL(m_scan.bbi));
-	}else{											//Search in the remaining blocks
-		for(int i=m_scan.bbi+1; i<m_nBB; i++){
-			if(_BitScanForward64(&posInBB,m_aBB[i])){
-				m_scan.bbi=i;
-				m_scan.pos=posInBB;
-				return (posInBB+ WMUL(i));
-			}
-		}
-	}
-	
-return EMPTY_ELEM;
+	return BBIntrinScan(*this).next_bit();
 }
 
-
 inline int BBIntrin::previous_bit		() {
-////////////////////////////
-// Date:13/4/2012
-// BitScan not destructive in reverse order (end-->begin)
-//
-// COMMENTS
-// 1-Require previous assignment BitBoardN::scan=0 and BitBoardN::scanv=MASK_LIM
-
-	unsigned long posInBB;
-				
-	//Search int the last table
-	if(_BitScanReverse64(&posInBB, m_aBB[m_scan.bbi] & Tables::mask_right[m_scan.pos])){
-		m_scan.pos =posInBB;
-		return (posInBB + WMUL(m_scan.bbi));
-	}else{											//Not found in the last table. Search in the rest
-		for(int i=m_scan.bbi-1; i>=0; i--){
-			if(_BitScanReverse64(&posInBB,m_aBB[i])){
-				m_scan.bbi=i;
-				m_scan.pos=posInBB;
-				return (posInBB+ WMUL(i));
-			}
-		}
-	}
-	
-return EMPTY_ELEM;
+	return BBIntrinScan(*this).previous_bit();
 }
 
 inline int BBIntrin::previous_bit_del() {
-//////////////
-// BitScan DI 
-	unsigned long posInBB;
-
-	for(int i=m_scan.bbi; i>=0; i--){
-		if(_BitScanReverse64(&posInBB,m_aBB[i])){
-			m_scan.bbi=i;
-			m_aBB[i]&=~Tables::mask[posInBB];			//Deleting before the return
-			return (posInBB+WMUL(i));
-		}
-	}
-return EMPTY_ELEM;  
+	return BBIntrinScan(*this).previous_bit_del();
 }
 
 inline int BBIntrin::previous_bit_del(int& nBB, BBIntrin& del) {
-//////////////
-// BitScan DI it also erase the returned bit of the table passed
-	unsigned long posInBB;
-
-	for(int i=m_scan.bbi; i>=0; i--){
-		if(_BitScanReverse64(&posInBB,m_aBB[i])){
-			m_scan.bbi=i;
-			m_aBB[i]&=~Tables::mask[posInBB];			//Deleting before the return
-			del.m_aBB[i]&=~Tables::mask[posInBB];
-			nBB=i;
-			return (posInBB+WMUL(i));
-		}
-	}
-	
-return EMPTY_ELEM;  
+	return BBIntrinScan(*this).previous_bit_del(nBB, del);
 }
 
 inline int BBIntrin::previous_bit_del(int& nBB) {
-//////////////
-// BitScan DI 
-	unsigned long posInBB;
-
-	for(int i=m_scan.bbi; i>=0; i--){
-		if(_BitScanReverse64(&posInBB,m_aBB[i])){
-			m_scan.bbi=i;
-			m_aBB[i]&=~Tables::mask[posInBB];			//Deleting before the return
-			nBB=i;
-			return (posInBB+WMUL(i));
-		}
-	}
-	
-return EMPTY_ELEM;  
+	return BBIntrinScan(*this).previous_bit_del(nBB);
 }
 
 inline
 int BBIntrin::init_scan(scan_types sct){
+	return BBIntrinScan(*this).init_scan(sct);
+}
+
+////////////////////////////
+// external cursor: non destructive scans only read the bitblocks
+
+inline
+int BBIntrin::init_scan(scan_cursor& sc, scan_types sct) const{
+	return BBIntrinScan(const_cast<BBIntrin&>(*this), sc).init_scan(sct);
+}
+
+inline
+int BBIntrin::init_scan_from(scan_cursor& sc, int from, scan_types sct) const{
 	switch(sct){
 	case NON_DESTRUCTIVE:
-		set_bbindex(0);
-		set_posbit(MASK_LIM);
-		break;
 	case NON_DESTRUCTIVE_REVERSE:
-		set_bbindex(m_nBB-1);
-		set_posbit(WORD_SIZE);		//mask_right[WORD_SIZE]=ONE
+		sc.bbi=WDIV(from);
+		sc.pos=WMOD(from);
 		break;
 	case DESTRUCTIVE:
-		set_bbindex(0); 
-		break;
 	case DESTRUCTIVE_REVERSE:
-		set_bbindex(m_nBB-1);
+		sc.bbi=WDIV(from); 
 		break;
 	default:
 		cerr<<"bad scan type"<<endl;
@@ -413,6 +299,26 @@ int BBIntrin::init_scan(scan_types sct){
 return 0;
 }
 
+inline int BBIntrin::next_bit(scan_cursor& sc) const{
+	return BBIntrinScan(const_cast<BBIntrin&>(*this), sc).next_bit();
+}
+
+inline int BBIntrin::next_bit(scan_cursor& sc, int& nBB) const{
+	return BBIntrinScan(const_cast<BBIntrin&>(*this), sc).next_bit(nBB);
+}
+
+inline int BBIntrin::previous_bit(scan_cursor& sc) const{
+	return BBIntrinScan(const_cast<BBIntrin&>(*this), sc).previous_bit();
+}
+
+inline int BBIntrin::next_bit_del(scan_cursor& sc){
+	return BBIntrinScan(*this, sc).next_bit_del();
+}
+
+inline int BBIntrin::previous_bit_del(scan_cursor& sc){
+	return BBIntrinScan(*this, sc).previous_bit_del();
+}
+
 inline
 int BBIntrin::init_scan_from (int from, scan_types sct){
 	switch(sct){
@@ -67,6 +67,17 @@ virtual inline int previous_bit		();
 	//bit scan backwards (destructive)
 inline int previous_bit_del			(); 
 inline int previous_bit_del			(int& nBB);
+
+	//scans with an external cursor (non destructive scans are const: several threads may scan the same bit string)
+inline int init_scan				(scan_cursor&, scan_types)				const;
+inline int init_scan_from			(scan_cursor&, int from, scan_types)	const;		//currently only for the NON-DESTRUCTIVE case
+inline int next_bit					(scan_cursor&)							const;
+inline int next_bit					(scan_cursor&, int& nBB)				const;
+inline int previous_bit				(scan_cursor&)							const;
+inline int next_bit_del				(scan_cursor&);
+inline int next_bit_del				(scan_cursor&, int& nBB);
+inline int previous_bit_del			(scan_cursor&);
+inline int previous_bit_del			(scan_cursor&, int& nBB);
 				
 /////////////////
 // Popcount
@@ -78,11 +89,7 @@ virtual	 inline int popcn64				(int nBit)	const;							//population size from (a
 //////////////////
 /// data members
 public:
-	struct scan_t{																			//Cache memory for bitscanning optimization
-		scan_t():bbi(EMPTY_ELEM), pos(MASK_LIM){}
-		int bbi;	//bitboard index in the collection (not in the bitstring) 	
-		int pos;	//bit position for bitscan		
-	};
+	typedef scan_cursor scan_t;																//Cache memory for bitscanning optimization (bbi: position in the collection)
 
 	 scan_t m_scan;
 };
@@ -185,25 +192,29 @@ return EMPTY_ELEM;
 
 
 inline int BBIntrinS::next_bit() {
+	return next_bit(m_scan);
+}
+
+inline int BBIntrinS::next_bit(scan_cursor& sc) const{
 ////////////////////////////
 // date:5/9/2014
 // non destructive bitscan for sparse bitstrings using intrinsics
 // caches index in the collection and pos inside the bitblock
 //
 // comments
-// 1-require previous assignment m_scan_bbi=0 and m_scan.pos=mask_lim
+// 1-require previous assignment sc.bbi=0 and sc.pos=mask_lim
 
 	unsigned long posbb;
 			
 	//search for next bit in the last block
-	if(_BitScanForward64(&posbb, m_aBB[m_scan.bbi].bb & Tables::mask_left[m_scan.pos])){
-		m_scan.pos =posbb;
-		return (posbb + WMUL(m_aBB[m_scan.bbi].index));
+	if(_BitScanForward64(&posbb, m_aBB[sc.bbi].bb & Tables::mask_left[sc.pos])){
+		sc.pos =posbb;
+		return (posbb + WMUL(m_aBB[sc.bbi].index));
 	}else{											//search in the remaining blocks
-		for(int i=m_scan.bbi+1; i<m_aBB.size(); i++){
+		for(int i=sc.bbi+1; i<m_aBB.size(); i++){
 			if(_BitScanForward64(&posbb,m_aBB[i].bb)){
-				m_scan.bbi=i;
-				m_scan.pos=posbb;
+				sc.bbi=i;
+				sc.pos=posbb;
 				return (posbb+ WMUL(m_aBB[i].index));
 			}
 		}
@@ -214,26 +225,30 @@ return EMPTY_ELEM;
 
 
 inline int BBIntrinS::next_bit(int& block_index) {
+	return next_bit(m_scan, block_index);
+}
+
+inline int BBIntrinS::next_bit(scan_cursor& sc, int& block_index) const{
 ////////////////////////////
 // date:5/9/2014
 // non destructive bitscan for sparse bitstrings using intrinsics
 // caches index in the collection and pos inside the bitblock
 //
 // comments
-// 1-require previous assignment m_scan_bbi=0 and m_scan.pos=mask_lim
+// 1-require previous assignment sc.bbi=0 and sc.pos=mask_lim
 
 	unsigned long posbb;
 			
 	//search for next bit in the last block
-	if(_BitScanForward64(&posbb, m_aBB[m_scan.bbi].bb & Tables::mask_left[m_scan.pos])){
-		m_scan.pos =posbb;
-		block_index= m_aBB[m_scan.bbi].index;
-		return (posbb + WMUL(m_aBB[m_scan.bbi].index));
+	if(_BitScanForward64(&posbb, m_aBB[sc.bbi].bb & Tables::mask_left[sc.pos])){
+		sc.pos =posbb;
+		block_index= m_aBB[sc.bbi].index;
+		return (posbb + WMUL(m_aBB[sc.bbi].index));
 	}else{											//search in the remaining blocks
-		for(int i=m_scan.bbi+1; i<m_aBB.size(); i++){
+		for(int i=sc.bbi+1; i<m_aBB.size(); i++){
 			if(_BitScanForward64(&posbb,m_aBB[i].bb)){
-				m_scan.bbi=i;
-				m_scan.pos=posbb;
+				sc.bbi=i;
+				sc.pos=posbb;
 				block_index=m_aBB[i].index;
 				return (posbb+ WMUL(m_aBB[i].index));
 			}
@@ -245,25 +260,29 @@ return EMPTY_ELEM;
 
 
 inline int BBIntrinS::previous_bit	() {
+	return previous_bit(m_scan);
+}
+
+inline int BBIntrinS::previous_bit(scan_cursor& sc) const{
 ////////////////////////////
 // date:5/9/2014
 // Non destructive bitscan for sparse bitstrings using intrinsics
 // caches index in the collection and pos inside the bitblock
 //
 // comments
-// 1-require previous assignment m_scan_bbi=number of bitblocks-1 and m_scan.pos=WORD_SIZE
+// 1-require previous assignment sc.bbi=number of bitblocks-1 and sc.pos=WORD_SIZE
 
 	unsigned long posbb;
 				
 	//search int the last table
-	if(_BitScanReverse64(&posbb, m_aBB[m_scan.bbi].bb & Tables::mask_right[m_scan.pos])){
-		m_scan.pos =posbb;
-		return (posbb + WMUL(m_aBB[m_scan.bbi].index));
+	if(_BitScanReverse64(&posbb, m_aBB[sc.bbi].bb & Tables::mask_right[sc.pos])){
+		sc.pos =posbb;
+		return (posbb + WMUL(m_aBB[sc.bbi].index));
 	}else{											//not found in the last table. search in the rest
-		for(int i=m_scan.bbi-1; i>=0; i--){
+		for(int i=sc.bbi-1; i>=0; i--){
 			if(_BitScanReverse64(&posbb,m_aBB[i].bb)){
-				m_scan.bbi=i;
-				m_scan.pos=posbb;
+				sc.bbi=i;
+				sc.pos=posbb;
 				return (posbb+ WMUL(m_aBB[i].index));
 			}
 		}
@@ -274,19 +293,23 @@ return EMPTY_ELEM;
 
 
 inline int BBIntrinS::next_bit_del() {
+	return next_bit_del(m_scan);
+}
+
+inline int BBIntrinS::next_bit_del(scan_cursor& sc) {
 ////////////////////////////
 //
 // date: 23/3/12
 // Destructive bitscan (scans and deletes each 1-bit) for sparse bitstrings using intrinsics
 //
 // COMMENTS
-// 1-Requires previous assignment m_scan_bbi=0 
+// 1-Requires previous assignment sc.bbi=0 
 
 	unsigned long posbb;
 
-	for(int i=m_scan.bbi; i<m_aBB.size(); i++)	{
+	for(int i=sc.bbi; i<m_aBB.size(); i++)	{
 		if(_BitScanForward64(&posbb,m_aBB[i].bb)){
-			m_scan.bbi=i;
+			sc.bbi=i;
 			m_aBB[i].bb&=~Tables::mask[posbb];			//deleting before the return
 			return (posbb + WMUL(m_aBB[i].index));
 		}
@@ -296,19 +319,23 @@ return EMPTY_ELEM;
 }
 
 inline int BBIntrinS::next_bit_del(int& block_index) {
+	return next_bit_del(m_scan, block_index);
+}
+
+inline int BBIntrinS::next_bit_del(scan_cursor& sc, int& block_index) {
 ////////////////////////////
 //
 // date: 23/3/12
 // Destructive bitscan for sparse bitstrings using intrinsics
 //
 // COMMENTS
-// 1-Requires previous assignment m_scan_bbi=0 
+// 1-Requires previous assignment sc.bbi=0 
 
 	unsigned long posbb;
 
-	for(int i=m_scan.bbi; i<m_aBB.size(); i++)	{
+	for(int i=sc.bbi; i<m_aBB.size(); i++)	{
 		if(_BitScanForward64(&posbb,m_aBB[i].bb)){
-			m_scan.bbi=i;
+			sc.bbi=i;
 			block_index=m_aBB[i].index;
 			m_aBB[i].bb&=~Tables::mask[posbb];			//deleting before the return
 			return (posbb + WMUL(m_aBB[i].index));
@@ -343,19 +370,23 @@ return EMPTY_ELEM;
 
 
 inline int BBIntrinS::previous_bit_del() {
+	return previous_bit_del(m_scan);
+}
+
+inline int BBIntrinS::previous_bit_del(scan_cursor& sc) {
 ////////////////////////////
 //
 // date: 23/3/12
 // Destructive bitscan for sparse bitstrings using intrinsics
 //
 // COMMENTS
-// 1-Requires previous assignment m_scan_bbi=number of bitblocks-1
+// 1-Requires previous assignment sc.bbi=number of bitblocks-1
 
 	unsigned long posbb;
 
-	for(int i=m_scan.bbi; i>=0; i--){
+	for(int i=sc.bbi; i>=0; i--){
 		if(_BitScanReverse64(&posbb,m_aBB[i].bb)){
-			m_scan.bbi=i;
+			sc.bbi=i;
 			m_aBB[i].bb&=~Tables::mask[posbb];			//deleting before the return
 			return (posbb+WMUL(m_aBB[i].index));
 		}
@@ -365,19 +396,23 @@ return EMPTY_ELEM;
 }
 
 inline int BBIntrinS::previous_bit_del(int & bb_index) {
+	return previous_bit_del(m_scan, bb_index);
+}
+
+inline int BBIntrinS::previous_bit_del(scan_cursor& sc, int& bb_index) {
 ////////////////////////////
 //
 // date: 23/3/12
 // Destructive bitscan for sparse bitstrings using intrinsics
 //
 // COMMENTS
-// 1-Requires previous assignment m_scan_bbi=number of bitblocks-1
+// 1-Requires previous assignment sc.bbi=number of bitblocks-1
 
 	unsigned long posbb;
 
-	for(int i=m_scan.bbi; i>=0; i--){
+	for(int i=sc.bbi; i>=0; i--){
 		if(_BitScanReverse64(&posbb,m_aBB[i].bb)){
-			m_scan.bbi=i;
+			sc.bbi=i;
 			bb_index=m_aBB[i].index;
 			m_aBB[i].bb&=~Tables::mask[posbb];			//deleting before the return
 			return (posbb+WMUL(m_aBB[i].index));
@@ -388,22 +423,27 @@ return EMPTY_ELEM;
 
 inline
 int BBIntrinS::init_scan (scan_types sct){
+	return init_scan(m_scan, sct);
+}
+
+inline
+int BBIntrinS::init_scan (scan_cursor& sc, scan_types sct) const{
 	if(m_aBB.empty()) return EMPTY_ELEM;				//necessary check since sparse bitstrings have empty semantics (i.e. sparse graphs)
 
 	switch(sct){
 	case NON_DESTRUCTIVE:
-		set_bbindex(0);
-		set_posbit(MASK_LIM);
+		sc.bbi=0;
+		sc.pos=MASK_LIM;
 		break;
 	case NON_DESTRUCTIVE_REVERSE:
-		set_bbindex(m_aBB.size()-1);
-		set_posbit(WORD_SIZE);
+		sc.bbi=m_aBB.size()-1;
+		sc.pos=WORD_SIZE;
 		break;
 	case DESTRUCTIVE:
-		set_bbindex(0); 
+		sc.bbi=0; 
 		break;
 	case DESTRUCTIVE_REVERSE:
-		set_bbindex(m_aBB.size()-1);
+		sc.bbi=m_aBB.size()-1;
 		break;
 	default:
 		cerr<<"bad scan type"<<endl;
@@ -414,6 +454,11 @@ return 0;
 
 inline
 int BBIntrinS::init_scan_from (int from, scan_types sct){
+	return init_scan_from(m_scan, from, sct);
+}
+
+inline
+int BBIntrinS::init_scan_from (scan_cursor& sc, int from, scan_types sct) const{
 ////////////////////////
 // scans starting at from until the end of the bitarray
 //
@@ -424,12 +469,12 @@ int BBIntrinS::init_scan_from (int from, scan_types sct){
 	switch(sct){
 	case NON_DESTRUCTIVE:
 	case NON_DESTRUCTIVE_REVERSE:
-		set_bbindex(p.second); 
-		(p.first)? set_posbit(WMOD(from)) : set_posbit(MASK_LIM);
+		sc.bbi=p.second; 
+		sc.pos=(p.first)? WMOD(from) : MASK_LIM;
 		break;
 	/*case DESTRUCTIVE:
 	case DESTRUCTIVE_REVERSE:
-		set_bbindex(p.second);
+		sc.bbi=p.second;
 		break;*/
 	default:
 		cerr<<"bad scan type"<<endl;
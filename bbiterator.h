@@ -0,0 +1,147 @@
+/*
+ * bbiterator.h file from the BITSCAN library, a C++ library for bit set
+ * optimization. BITSCAN has been used to implement BBMC, a very
+ * succesful bit-parallel algorithm for exact maximum clique.
+ * (see license file for references)
+ *
+ * Copyright (C)
+ * Author: Pablo San Segundo
+ * Intelligent Control Research Group (CSIC-UPM)
+ *
+ * Permission to use, modify and distribute this software is
+ * granted provided that this copyright notice appears in all
+ * copies, in source code or in binaries. For precise terms
+ * see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any
+ * kind, express or implied, and with no claim as to its
+ * suitability for any purpose.
+ *
+ */
+
+#ifndef __BB_ITERATOR_H__
+#define __BB_ITERATOR_H__
+
+#include "bitboard.h"
+#include <iterator>
+
+/////////////////////////////////
+//
+// Range-for iteration over the 1-bits of a bit string
+//
+//	for(int v : bb.bits()) {...}				//increasing order
+//	for(int v : bb.bits_reverse()) {...}		//decreasing order
+//
+// The cursor lives in the iterator (current bitblock and what remains of it), so
+// a const bit string may be scanned by any number of simultaneous (or nested) loops.
+// Each step is a bit scan and a clear of the bit scanned (tzcnt/blsr).
+// The bit string must not be modified during the scan.
+//
+///////////////////////////////////
+
+//block access policies: bitblock and bitblock index of the i-th stored block
+struct BBDenseBlock{
+	typedef BITBOARD elem_t;
+	static BITBOARD bits			(const elem_t* aBB, int i)		{return aBB[i];}
+	static int index				(const elem_t* aBB, int i)		{return i;}
+};
+
+template<class Elem>
+struct BBSparseBlock{
+	typedef Elem elem_t;
+	static BITBOARD bits			(const elem_t* aBB, int i)		{return aBB[i].bb;}
+	static int index				(const elem_t* aBB, int i)		{return aBB[i].index;}
+};
+
+template<class Block, bool REVERSE>
+class BBBitIterator{
+public:
+	typedef std::forward_iterator_tag iterator_category;
+	typedef int value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef const int* pointer;
+	typedef int reference;
+	typedef typename Block::elem_t elem_t;
+
+	BBBitIterator						(const elem_t* aBB, int i, int end):m_aBB(aBB), m_i(i), m_end(end), m_bb(0){ skip_empty(); }
+
+	int operator *						()	const;
+	BBBitIterator& operator ++			();
+	BBBitIterator operator ++			(int)								{BBBitIterator it(*this); ++(*this); return it;}
+	bool operator ==					(const BBBitIterator& rhs)	const	{return (m_i==rhs.m_i && m_bb==rhs.m_bb);}
+	bool operator !=					(const BBBitIterator& rhs)	const	{return !(*this==rhs);}
+
+private:
+	void skip_empty						();
+
+	const elem_t* m_aBB;
+	int m_i;																//current block
+	int m_end;																//first block out of range (last-1 if REVERSE)
+	BITBOARD m_bb;															//bits of the current block not yet scanned
+};
+
+template<class Block, bool REVERSE>
+class BBBitRange{
+public:
+	typedef BBBitIterator<Block, REVERSE> iterator;
+	typedef iterator const_iterator;
+	typedef typename Block::elem_t elem_t;
+
+	//blocks [first, last] (empty if last<first)
+	BBBitRange							(const elem_t* aBB, int first, int last):m_aBB(aBB), m_first(first), m_last((last<first)? first-1 : last){}
+
+	iterator begin						()	const	{return (REVERSE)? iterator(m_aBB, m_last, m_first-1) : iterator(m_aBB, m_first, m_last+1);}
+	iterator end						()	const	{return (REVERSE)? iterator(m_aBB, m_first-1, m_first-1) : iterator(m_aBB, m_last+1, m_last+1);}
+	bool empty							()	const	{return !(begin()!=end());}
+
+private:
+	const elem_t* m_aBB;
+	int m_first;
+	int m_last;
+};
+
+///////////////////////
+//
+// INLINE FUNCTIONS
+//
+////////////////////////
+
+template<class Block, bool REVERSE>
+inline void BBBitIterator<Block, REVERSE>::skip_empty(){
+/////////////////////
+// moves to the next non-empty block (m_bb==0 at the end)
+
+	while((REVERSE)? m_i>m_end : m_i<m_end){
+		if((m_bb=Block::bits(m_aBB, m_i))) return;
+		(REVERSE)? m_i-- : m_i++;
+	}
+	m_bb=0;
+}
+
+template<class Block, bool REVERSE>
+inline int BBBitIterator<Block, REVERSE>::operator *() const{
+	unsigned long posInBB;
+	if(REVERSE)
+		_BitScanReverse64(&posInBB, m_bb);
+	else
+		_BitScanForward64(&posInBB, m_bb);
+return (posInBB + WMUL(Block::index(m_aBB, m_i)));
+}
+
+template<class Block, bool REVERSE>
+inline BBBitIterator<Block, REVERSE>& BBBitIterator<Block, REVERSE>::operator ++(){
+	if(REVERSE){
+		unsigned long posInBB;
+		_BitScanReverse64(&posInBB, m_bb);
+		m_bb&=~Tables::mask[posInBB];
+	}else
+		m_bb&=m_bb-1;													//clears the least significant bit (blsr)
+
+	if(!m_bb){
+		(REVERSE)? m_i-- : m_i++;
+		skip_empty();
+	}
+return *this;
+}
+
+#endif
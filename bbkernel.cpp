@@ -0,0 +1,621 @@
+// bbkernel.cpp: implementation of the vectorized kernels for arrays of bitblocks
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "bbkernel.h"
+
+#ifdef __GNUC__
+	#include <x86intrin.h>
+	#define TARGET_SSE2		__attribute__((target("sse2")))
+	#define TARGET_AVX2		__attribute__((target("avx2")))
+	#define TARGET_AVX512	__attribute__((target("avx512f")))
+	#define TARGET_AVX2_POPC		__attribute__((target("avx2,popcnt")))
+	#define TARGET_AVX512_POPC		__attribute__((target("avx512f,avx512vpopcntdq")))
+	#define TARGET_AVX512_DECODE	__attribute__((target("avx512f,popcnt")))
+	#define POPCOUNT64(bb)	__builtin_popcountll(bb)
+	#define CTZ64(bb)		__builtin_ctzll(bb)
+#else
+	#include <intrin.h>										//windows specific
+	#include <immintrin.h>
+	#define TARGET_SSE2
+	#define TARGET_AVX2
+	#define TARGET_AVX512
+	#define TARGET_AVX2_POPC
+	#define TARGET_AVX512_POPC
+	#define TARGET_AVX512_DECODE
+	#define POPCOUNT64(bb)	__popcnt64(bb)
+	#define CTZ64(bb)		ctz64(bb)
+	static inline int ctz64(unsigned long long bb){unsigned long i; _BitScanForward64(&i, bb); return (int)i;}
+#endif
+
+enum op_t {OP_AND, OP_OR, OP_XOR, OP_ANDNOT, OP_LHS};					//OP_LHS: lhs alone (population count only)
+
+//////////////////////////
+//
+// SCALAR
+//
+//////////////////////////
+
+template<int OP>
+static inline BITBOARD op_scalar(BITBOARD a, BITBOARD b){
+	switch(OP){
+	case OP_AND:	return a & b;
+	case OP_OR:		return a | b;
+	case OP_XOR:	return a ^ b;
+	case OP_ANDNOT:	return a & ~b;
+	default:		return a;
+	}
+}
+
+template<int OP>
+static void binop_scalar(BITBOARD* res, const BITBOARD* lhs, const BITBOARD* rhs, int nBB){
+	for(int i=0; i<nBB; i++)
+		res[i]=op_scalar<OP>(lhs[i], rhs[i]);
+}
+
+static void not_scalar(BITBOARD* res, const BITBOARD* lhs, int nBB){
+	for(int i=0; i<nBB; i++)
+		res[i]=~lhs[i];
+}
+
+template<int OP>
+static int popop_scalar(const BITBOARD* lhs, const BITBOARD* rhs, int nBB){
+	BITBOARD pc=0;
+	for(int i=0; i<nBB; i++)
+		pc+=POPCOUNT64(op_scalar<OP>(lhs[i], (OP==OP_LHS)? 0 : rhs[i]));
+return (int)pc;
+}
+
+static int popc_scalar(const BITBOARD* lhs, int nBB){
+	return popop_scalar<OP_LHS>(lhs, 0, nBB);
+}
+
+static int decode_scalar(const BITBOARD* lhs, int nBB, int offset, int* out, int max){
+	int n=0;
+	for(int i=0; i<nBB; i++){
+		BITBOARD bb=lhs[i];
+		int base=offset+i*WORD_SIZE;
+		while(bb){
+			if(n==max) return n;
+			out[n++]=base+CTZ64(bb);
+			bb&=bb-1;
+		}
+	}
+return n;
+}
+
+//64x64 transpose: stage j swaps the j x j off-diagonal subblocks of every 2j x 2j block
+static const BITBOARD transpose_mask[6]={0x00000000FFFFFFFFULL, 0x0000FFFF0000FFFFULL, 0x00FF00FF00FF00FFULL,
+										 0x0F0F0F0F0F0F0F0FULL, 0x3333333333333333ULL, 0x5555555555555555ULL};		//j=32, 16, ..., 1
+
+static inline void transpose_stage(BITBOARD* a, int j, BITBOARD m){
+	for(int k=0; k<64; k=((k|j)+1)&~j){
+		BITBOARD t=((a[k]>>j)^a[k|j]) & m;
+		a[k]^=t<<j;
+		a[k|j]^=t;
+	}
+}
+
+static void transpose64_scalar(BITBOARD* a){
+	for(int s=0, j=32; j; s++, j>>=1)
+		transpose_stage(a, j, transpose_mask[s]);
+}
+
+//////////////////////////
+//
+// SSE2 (2 bitblocks per operation)
+//
+//////////////////////////
+
+template<int OP>
+TARGET_SSE2 static inline __m128i op_sse2(__m128i a, __m128i b){
+	switch(OP){
+	case OP_AND:	return _mm_and_si128(a, b);
+	case OP_OR:		return _mm_or_si128(a, b);
+	case OP_XOR:	return _mm_xor_si128(a, b);
+	default:		return _mm_andnot_si128(b, a);						//andnot negates the first operand
+	}
+}
+
+template<int OP>
+TARGET_SSE2 static void binop_sse2(BITBOARD* res, const BITBOARD* lhs, const BITBOARD* rhs, int nBB){
+	int i=0;
+	for(; i+2<=nBB; i+=2){
+		__m128i a=_mm_loadu_si128((const __m128i*)(lhs+i));
+		__m128i b=_mm_loadu_si128((const __m128i*)(rhs+i));
+		_mm_storeu_si128((__m128i*)(res+i), op_sse2<OP>(a, b));
+	}
+	for(; i<nBB; i++)
+		res[i]=op_scalar<OP>(lhs[i], rhs[i]);
+}
+
+TARGET_SSE2 static void not_sse2(BITBOARD* res, const BITBOARD* lhs, int nBB){
+	const __m128i ones=_mm_set1_epi32(-1);
+	int i=0;
+	for(; i+2<=nBB; i+=2){
+		__m128i a=_mm_loadu_si128((const __m128i*)(lhs+i));
+		_mm_storeu_si128((__m128i*)(res+i), _mm_xor_si128(a, ones));
+	}
+	for(; i<nBB; i++)
+		res[i]=~lhs[i];
+}
+
+TARGET_SSE2 static void transpose64_sse2(BITBOARD* a){
+//////////////////
+// stages with j>=2 swap pairs of consecutive rows, the last one is scalar
+
+	int s=0;
+	for(int j=32; j>=2; j>>=1, s++){
+		const __m128i m=_mm_set1_epi64x(transpose_mask[s]);
+		const __m128i sh=_mm_cvtsi32_si128(j);
+		for(int base=0; base<64; base+=2*j){
+			for(int k=base; k<base+j; k+=2){
+				__m128i x=_mm_loadu_si128((const __m128i*)(a+k));
+				__m128i y=_mm_loadu_si128((const __m128i*)(a+k+j));
+				__m128i t=_mm_and_si128(_mm_xor_si128(_mm_srl_epi64(x, sh), y), m);
+				_mm_storeu_si128((__m128i*)(a+k), _mm_xor_si128(x, _mm_sll_epi64(t, sh)));
+				_mm_storeu_si128((__m128i*)(a+k+j), _mm_xor_si128(y, t));
+			}
+		}
+	}
+	transpose_stage(a, 1, transpose_mask[5]);
+}
+
+//////////////////////////
+//
+// AVX2 (4 bitblocks per operation)
+//
+//////////////////////////
+
+template<int OP>
+TARGET_AVX2 static inline __m256i op_avx2(__m256i a, __m256i b){
+	switch(OP){
+	case OP_AND:	return _mm256_and_si256(a, b);
+	case OP_OR:		return _mm256_or_si256(a, b);
+	case OP_XOR:	return _mm256_xor_si256(a, b);
+	case OP_ANDNOT:	return _mm256_andnot_si256(b, a);
+	default:		return a;
+	}
+}
+
+template<int OP>
+TARGET_AVX2 static void binop_avx2(BITBOARD* res, const BITBOARD* lhs, const BITBOARD* rhs, int nBB){
+	int i=0;
+	for(; i+8<=nBB; i+=8){													//two vectors per iteration
+		__m256i a0=_mm256_loadu_si256((const __m256i*)(lhs+i));
+		__m256i a1=_mm256_loadu_si256((const __m256i*)(lhs+i+4));
+		__m256i b0=_mm256_loadu_si256((const __m256i*)(rhs+i));
+		__m256i b1=_mm256_loadu_si256((const __m256i*)(rhs+i+4));
+		_mm256_storeu_si256((__m256i*)(res+i), op_avx2<OP>(a0, b0));
+		_mm256_storeu_si256((__m256i*)(res+i+4), op_avx2<OP>(a1, b1));
+	}
+	for(; i+4<=nBB; i+=4){
+		__m256i a=_mm256_loadu_si256((const __m256i*)(lhs+i));
+		__m256i b=_mm256_loadu_si256((const __m256i*)(rhs+i));
+		_mm256_storeu_si256((__m256i*)(res+i), op_avx2<OP>(a, b));
+	}
+	for(; i<nBB; i++)
+		res[i]=op_scalar<OP>(lhs[i], rhs[i]);
+}
+
+TARGET_AVX2 static void not_avx2(BITBOARD* res, const BITBOARD* lhs, int nBB){
+	const __m256i ones=_mm256_set1_epi32(-1);
+	int i=0;
+	for(; i+4<=nBB; i+=4){
+		__m256i a=_mm256_loadu_si256((const __m256i*)(lhs+i));
+		_mm256_storeu_si256((__m256i*)(res+i), _mm256_xor_si256(a, ones));
+	}
+	for(; i<nBB; i++)
+		res[i]=~lhs[i];
+}
+
+template<int OP>
+TARGET_AVX2 static inline __m256i load_avx2(const BITBOARD* lhs, const BITBOARD* rhs, int i){
+	__m256i a=_mm256_loadu_si256((const __m256i*)(lhs+i));
+	if(OP==OP_LHS) return a;
+	return op_avx2<OP>(a, _mm256_loadu_si256((const __m256i*)(rhs+i)));
+}
+
+TARGET_AVX2 static inline __m256i popcount_avx2(__m256i v){
+///////////////////
+// nibble lookup with vpshufb (Mula), returns 4 partial sums of 64 bits
+
+	const __m256i lookup=_mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4, 0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+	const __m256i low_mask=_mm256_set1_epi8(0x0f);
+	__m256i lo=_mm256_and_si256(v, low_mask);
+	__m256i hi=_mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+	__m256i cnt=_mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+
+TARGET_AVX2 static inline void csa_avx2(__m256i& h, __m256i& l, __m256i a, __m256i b, __m256i c){
+///////////////////
+// carry-save adder: h (carry) and l (sum) of a+b+c
+	__m256i u=_mm256_xor_si256(a, b);
+	h=_mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+	l=_mm256_xor_si256(u, c);
+}
+
+template<int OP>
+TARGET_AVX2_POPC static int popop_avx2(const BITBOARD* lhs, const BITBOARD* rhs, int nBB){
+///////////////////
+// Harley-Seal population count over blocks of 16 vectors (64 bitblocks)
+
+	const __m256i zero=_mm256_setzero_si256();
+	__m256i total=zero, ones=zero, twos=zero, fours=zero, eights=zero, sixteens;
+	__m256i twosA, twosB, foursA, foursB, eightsA, eightsB;
+	int i=0;
+
+	for(; i+64<=nBB; i+=64){
+		csa_avx2(twosA, ones, ones, load_avx2<OP>(lhs, rhs, i), load_avx2<OP>(lhs, rhs, i+4));
+		csa_avx2(twosB, ones, ones, load_avx2<OP>(lhs, rhs, i+8), load_avx2<OP>(lhs, rhs, i+12));
+		csa_avx2(foursA, twos, twos, twosA, twosB);
+		csa_avx2(twosA, ones, ones, load_avx2<OP>(lhs, rhs, i+16), load_avx2<OP>(lhs, rhs, i+20));
+		csa_avx2(twosB, ones, ones, load_avx2<OP>(lhs, rhs, i+24), load_avx2<OP>(lhs, rhs, i+28));
+		csa_avx2(foursB, twos, twos, twosA, twosB);
+		csa_avx2(eightsA, fours, fours, foursA, foursB);
+		csa_avx2(twosA, ones, ones, load_avx2<OP>(lhs, rhs, i+32), load_avx2<OP>(lhs, rhs, i+36));
+		csa_avx2(twosB, ones, ones, load_avx2<OP>(lhs, rhs, i+40), load_avx2<OP>(lhs, rhs, i+44));
+		csa_avx2(foursA, twos, twos, twosA, twosB);
+		csa_avx2(twosA, ones, ones, load_avx2<OP>(lhs, rhs, i+48), load_avx2<OP>(lhs, rhs, i+52));
+		csa_avx2(twosB, ones, ones, load_avx2<OP>(lhs, rhs, i+56), load_avx2<OP>(lhs, rhs, i+60));
+		csa_avx2(foursB, twos, twos, twosA, twosB);
+		csa_avx2(eightsB, fours, fours, foursA, foursB);
+		csa_avx2(sixteens, eights, eights, eightsA, eightsB);
+		total=_mm256_add_epi64(total, popcount_avx2(sixteens));
+	}
+
+	total=_mm256_slli_epi64(total, 4);
+	total=_mm256_add_epi64(total, _mm256_slli_epi64(popcount_avx2(eights), 3));
+	total=_mm256_add_epi64(total, _mm256_slli_epi64(popcount_avx2(fours), 2));
+	total=_mm256_add_epi64(total, _mm256_slli_epi64(popcount_avx2(twos), 1));
+	total=_mm256_add_epi64(total, popcount_avx2(ones));
+
+	for(; i+4<=nBB; i+=4)
+		total=_mm256_add_epi64(total, popcount_avx2(load_avx2<OP>(lhs, rhs, i)));
+	
+	BITBOARD pc=(BITBOARD)_mm256_extract_epi64(total, 0) + (BITBOARD)_mm256_extract_epi64(total, 1) +
+				(BITBOARD)_mm256_extract_epi64(total, 2) + (BITBOARD)_mm256_extract_epi64(total, 3);
+	for(; i<nBB; i++)
+		pc+=POPCOUNT64(op_scalar<OP>(lhs[i], (OP==OP_LHS)? 0 : rhs[i]));
+return (int)pc;
+}
+
+static unsigned char decode_lut[256][8];						//positions of the 1-bits of each byte
+static unsigned char decode_lut_pc[256];						//population of each byte
+
+static void init_decode_lut(){
+	for(int b=0; b<256; b++){
+		int k=0;
+		for(int j=0; j<8; j++)
+			if(b & (1<<j)) decode_lut[b][k++]=(unsigned char)j;
+		decode_lut_pc[b]=(unsigned char)k;
+	}
+}
+
+TARGET_AVX2_POPC static int decode_avx2(const BITBOARD* lhs, int nBB, int offset, int* out, int max){
+///////////////////
+// each non-empty byte expands to 8 indexes (lookup table) stored in full: only the 
+// first popcount(byte) are kept. Bitblocks whose stores could overflow out are decoded by the scalar kernel
+
+	int n=0;
+	for(int i=0; i<nBB; i++){
+		BITBOARD bb=lhs[i];
+		if(!bb) continue;
+		int base=offset+i*WORD_SIZE;
+		if(n+POPCOUNT64(bb)+7>max)
+			return n+decode_scalar(lhs+i, nBB-i, base, out+n, max-n);
+
+		for(int k=0; k<8; k++, bb>>=8){
+			unsigned int byte=(unsigned int)(bb & 0xFF);
+			if(!byte) continue;
+			__m256i idx=_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)decode_lut[byte]));
+			_mm256_storeu_si256((__m256i*)(out+n), _mm256_add_epi32(idx, _mm256_set1_epi32(base+8*k)));
+			n+=decode_lut_pc[byte];
+		}
+	}
+return n;
+}
+
+TARGET_AVX2_POPC static int popc_avx2(const BITBOARD* lhs, int nBB){
+	return popop_avx2<OP_LHS>(lhs, 0, nBB);
+}
+
+TARGET_AVX2 static void transpose64_avx2(BITBOARD* a){
+//////////////////
+// stages with j>=4 swap groups of 4 consecutive rows, the last two are scalar
+
+	int s=0;
+	for(int j=32; j>=4; j>>=1, s++){
+		const __m256i m=_mm256_set1_epi64x(transpose_mask[s]);
+		const __m128i sh=_mm_cvtsi32_si128(j);
+		for(int base=0; base<64; base+=2*j){
+			for(int k=base; k<base+j; k+=4){
+				__m256i x=_mm256_loadu_si256((const __m256i*)(a+k));
+				__m256i y=_mm256_loadu_si256((const __m256i*)(a+k+j));
+				__m256i t=_mm256_and_si256(_mm256_xor_si256(_mm256_srl_epi64(x, sh), y), m);
+				_mm256_storeu_si256((__m256i*)(a+k), _mm256_xor_si256(x, _mm256_sll_epi64(t, sh)));
+				_mm256_storeu_si256((__m256i*)(a+k+j), _mm256_xor_si256(y, t));
+			}
+		}
+	}
+	transpose_stage(a, 2, transpose_mask[4]);
+	transpose_stage(a, 1, transpose_mask[5]);
+}
+
+//////////////////////////
+//
+// AVX-512 (8 bitblocks per operation, masked tail)
+//
+//////////////////////////
+
+template<int OP>
+TARGET_AVX512 static inline __m512i op_avx512(__m512i a, __m512i b){
+	switch(OP){
+	case OP_AND:	return _mm512_and_si512(a, b);
+	case OP_OR:		return _mm512_or_si512(a, b);
+	case OP_XOR:	return _mm512_xor_si512(a, b);
+	case OP_ANDNOT:	return _mm512_mask_andnot_epi64(_mm512_setzero_si512(), (__mmask8)0xFF, b, a);		//explicit pass-through (GCC 12 -Wuninitialized)
+	default:		return a;
+	}
+}
+
+template<int OP>
+TARGET_AVX512 static void binop_avx512(BITBOARD* res, const BITBOARD* lhs, const BITBOARD* rhs, int nBB){
+	int i=0;
+	for(; i+8<=nBB; i+=8){
+		__m512i a=_mm512_loadu_si512((const void*)(lhs+i));
+		__m512i b=_mm512_loadu_si512((const void*)(rhs+i));
+		_mm512_storeu_si512((void*)(res+i), op_avx512<OP>(a, b));
+	}
+	if(i<nBB){
+		__mmask8 m=(__mmask8)((1u<<(nBB-i))-1);
+		__m512i a=_mm512_maskz_loadu_epi64(m, (const void*)(lhs+i));
+		__m512i b=_mm512_maskz_loadu_epi64(m, (const void*)(rhs+i));
+		_mm512_mask_storeu_epi64((void*)(res+i), m, op_avx512<OP>(a, b));
+	}
+}
+
+TARGET_AVX512 static void not_avx512(BITBOARD* res, const BITBOARD* lhs, int nBB){
+	const __m512i ones=_mm512_set1_epi32(-1);
+	int i=0;
+	for(; i+8<=nBB; i+=8){
+		__m512i a=_mm512_loadu_si512((const void*)(lhs+i));
+		_mm512_storeu_si512((void*)(res+i), _mm512_xor_si512(a, ones));
+	}
+	if(i<nBB){
+		__mmask8 m=(__mmask8)((1u<<(nBB-i))-1);
+		__m512i a=_mm512_maskz_loadu_epi64(m, (const void*)(lhs+i));
+		_mm512_mask_storeu_epi64((void*)(res+i), m, _mm512_xor_si512(a, ones));
+	}
+}
+
+template<int OP>
+TARGET_AVX512_POPC static int popop_avx512(const BITBOARD* lhs, const BITBOARD* rhs, int nBB){
+///////////////////
+// VPOPCNTQ population count (requires AVX512_VPOPCNTDQ)
+
+	__m512i total=_mm512_setzero_si512();
+	int i=0;
+	for(; i+8<=nBB; i+=8){
+		__m512i a=_mm512_loadu_si512((const void*)(lhs+i));
+		if(OP!=OP_LHS) a=op_avx512<OP>(a, _mm512_loadu_si512((const void*)(rhs+i)));
+		total=_mm512_add_epi64(total, _mm512_popcnt_epi64(a));
+	}
+	if(i<nBB){
+		__mmask8 m=(__mmask8)((1u<<(nBB-i))-1);
+		__m512i a=_mm512_maskz_loadu_epi64(m, (const void*)(lhs+i));
+		if(OP!=OP_LHS) a=op_avx512<OP>(a, _mm512_maskz_loadu_epi64(m, (const void*)(rhs+i)));
+		total=_mm512_add_epi64(total, _mm512_popcnt_epi64(a));
+	}
+	BITBOARD lanes[8];															//not _mm512_reduce_add_epi64: its extracts have undefined pass-through vectors (GCC 12 -Wuninitialized)
+	_mm512_storeu_si512((void*)lanes, total);
+return (int)(lanes[0]+lanes[1]+lanes[2]+lanes[3]+lanes[4]+lanes[5]+lanes[6]+lanes[7]);
+}
+
+TARGET_AVX512_POPC static int popc_avx512(const BITBOARD* lhs, int nBB){
+	return popop_avx512<OP_LHS>(lhs, 0, nBB);
+}
+
+TARGET_AVX512_DECODE static int decode_avx512(const BITBOARD* lhs, int nBB, int offset, int* out, int max){
+///////////////////
+// every 16 bits of a bitblock select (VPCOMPRESSD) from a vector of 16 consecutive indexes
+
+	const __m512i iota=_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	const __m512i sixteen=_mm512_set1_epi32(16);
+	int n=0;
+	for(int i=0; i<nBB; i++){
+		BITBOARD bb=lhs[i];
+		if(!bb) continue;
+		int base=offset+i*WORD_SIZE;
+		if(n+POPCOUNT64(bb)>max)
+			return n+decode_scalar(lhs+i, nBB-i, base, out+n, max-n);
+
+		__m512i idx=_mm512_add_epi32(iota, _mm512_set1_epi32(base));
+		for(int k=0; k<4; k++, bb>>=16){
+			__mmask16 m=(__mmask16)(bb & 0xFFFF);
+			if(m){
+				_mm512_mask_compressstoreu_epi32(out+n, m, idx);
+				n+=POPCOUNT64(m);
+			}
+			idx=_mm512_add_epi32(idx, sixteen);
+		}
+	}
+return n;
+}
+
+//////////////////////////
+//
+// DISPATCH
+//
+//////////////////////////
+
+BBKernel::isa_t		BBKernel::m_isa=BBKernel::SCALAR;
+BBKernel::binop_t	BBKernel::bb_and=binop_scalar<OP_AND>;
+BBKernel::binop_t	BBKernel::bb_or=binop_scalar<OP_OR>;
+BBKernel::binop_t	BBKernel::bb_xor=binop_scalar<OP_XOR>;
+BBKernel::binop_t	BBKernel::bb_andnot=binop_scalar<OP_ANDNOT>;
+BBKernel::unop_t	BBKernel::bb_not=not_scalar;
+BBKernel::popc_t	BBKernel::bb_popc=popc_scalar;
+BBKernel::popop_t	BBKernel::bb_popc_and=popop_scalar<OP_AND>;
+BBKernel::popop_t	BBKernel::bb_popc_or=popop_scalar<OP_OR>;
+BBKernel::popop_t	BBKernel::bb_popc_xor=popop_scalar<OP_XOR>;
+BBKernel::popop_t	BBKernel::bb_popc_andnot=popop_scalar<OP_ANDNOT>;
+BBKernel::decode_t	BBKernel::bb_decode=decode_scalar;
+BBKernel::transp_t	BBKernel::bb_transpose64=transpose64_scalar;
+
+//global selection of kernels at startup
+struct InitKernels{
+	InitKernels(){BBKernel::init();}
+} initKernels;
+
+bool BBKernel::is_supported(isa_t isa){
+///////////////////
+// CPU (and OS) support for the instruction set
+
+#ifdef __GNUC__
+	__builtin_cpu_init();
+	switch(isa){
+	case SCALAR:	return true;
+	case SSE2:		return __builtin_cpu_supports("sse2");
+	case AVX2:		return __builtin_cpu_supports("avx2");
+	case AVX512:	return __builtin_cpu_supports("avx512f");
+	}
+#else
+	int r[4];
+	__cpuid(r, 0);
+	int nids=r[0];
+	__cpuid(r, 1);
+	bool sse2=(r[3]>>26)&1;
+	bool osxsave=(r[2]>>27)&1;
+	switch(isa){
+	case SCALAR:	return true;
+	case SSE2:		return sse2;
+	case AVX2:
+	case AVX512:
+		if(!osxsave || nids<7) return false;
+		unsigned long long xcr0=_xgetbv(0);
+		__cpuidex(r, 7, 0);
+		if(isa==AVX2) return ((xcr0 & 0x6)==0x6) && ((r[1]>>5)&1);
+		return ((xcr0 & 0xe6)==0xe6) && ((r[1]>>16)&1);
+	}
+#endif
+return false;
+}
+
+bool BBKernel::has_vpopcnt(){
+#ifdef __GNUC__
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx512vpopcntdq");
+#else
+	if(!is_supported(AVX512)) return false;
+	int r[4];
+	__cpuidex(r, 7, 0);
+	return (r[2]>>14)&1;
+#endif
+}
+
+const char* BBKernel::isa_name(isa_t isa){
+	switch(isa){
+	case SCALAR:	return "scalar";
+	case SSE2:		return "sse2";
+	case AVX2:		return "avx2";
+	case AVX512:	return "avx512";
+	}
+return "unknown";
+}
+
+int BBKernel::set_isa(isa_t isa){
+///////////////////
+// forces the kernels of an instruction set (i.e. for tests or benchmarks)
+//
+// RETURNS -1 if not supported by the CPU, 0 otherwise
+
+	if(!is_supported(isa)) return -1;
+
+	switch(isa){
+	case SCALAR:
+		bb_and=binop_scalar<OP_AND>;	bb_or=binop_scalar<OP_OR>;
+		bb_xor=binop_scalar<OP_XOR>;	bb_andnot=binop_scalar<OP_ANDNOT>;
+		bb_not=not_scalar;
+		break;
+	case SSE2:
+		bb_and=binop_sse2<OP_AND>;		bb_or=binop_sse2<OP_OR>;
+		bb_xor=binop_sse2<OP_XOR>;		bb_andnot=binop_sse2<OP_ANDNOT>;
+		bb_not=not_sse2;
+		break;
+	case AVX2:
+		bb_and=binop_avx2<OP_AND>;		bb_or=binop_avx2<OP_OR>;
+		bb_xor=binop_avx2<OP_XOR>;		bb_andnot=binop_avx2<OP_ANDNOT>;
+		bb_not=not_avx2;
+		break;
+	case AVX512:
+		bb_and=binop_avx512<OP_AND>;	bb_or=binop_avx512<OP_OR>;
+		bb_xor=binop_avx512<OP_XOR>;	bb_andnot=binop_avx512<OP_ANDNOT>;
+		bb_not=not_avx512;
+		break;
+	}
+
+	//population count kernels
+	switch(isa){
+	case SCALAR:
+	case SSE2:										//no SSE2 population count: scalar popcount is used
+		bb_popc=popc_scalar;
+		bb_popc_and=popop_scalar<OP_AND>;		bb_popc_or=popop_scalar<OP_OR>;
+		bb_popc_xor=popop_scalar<OP_XOR>;		bb_popc_andnot=popop_scalar<OP_ANDNOT>;
+		break;
+	case AVX2:
+	case AVX512:
+		if(isa==AVX512 && has_vpopcnt()){
+			bb_popc=popc_avx512;
+			bb_popc_and=popop_avx512<OP_AND>;	bb_popc_or=popop_avx512<OP_OR>;
+			bb_popc_xor=popop_avx512<OP_XOR>;	bb_popc_andnot=popop_avx512<OP_ANDNOT>;
+		}else{
+			bb_popc=popc_avx2;
+			bb_popc_and=popop_avx2<OP_AND>;		bb_popc_or=popop_avx2<OP_OR>;
+			bb_popc_xor=popop_avx2<OP_XOR>;		bb_popc_andnot=popop_avx2<OP_ANDNOT>;
+		}
+		break;
+	}
+
+	//transpose kernels (AVX2 for AVX-512: 64 rows are only 8 registers)
+	switch(isa){
+	case SCALAR:	bb_transpose64=transpose64_scalar;	break;
+	case SSE2:		bb_transpose64=transpose64_sse2;	break;
+	case AVX2:
+	case AVX512:	bb_transpose64=transpose64_avx2;	break;
+	}
+
+	//decoding kernels
+	switch(isa){
+	case SCALAR:
+	case SSE2:
+		bb_decode=decode_scalar;
+		break;
+	case AVX2:
+		init_decode_lut();
+		bb_decode=decode_avx2;
+		break;
+	case AVX512:
+		bb_decode=decode_avx512;
+		break;
+	}
+
+	m_isa=isa;
+return 0;
+}
+
+int BBKernel::init(){
+///////////////////
+// selects the best instruction set available (SIMD_KERNELS switch in config.h)
+
+#ifdef SIMD_KERNELS
+#ifdef SIMD_AVX512
+	if(set_isa(AVX512)==0) return 0;
+#endif
+	if(set_isa(AVX2)==0) return 0;
+	if(set_isa(SSE2)==0) return 0;
+#endif
+	set_isa(SCALAR);
+return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ * bbkernel.h file from the BITSCAN library, a C++ library for bit set
+ * optimization. BITSCAN has been used to implement BBMC, a very
+ * succesful bit-parallel algorithm for exact maximum clique.
+ * (see license file for references)
+ *
+ * Copyright (C)
+ * Author: Pablo San Segundo
+ * Intelligent Control Research Group (CSIC-UPM)
+ *
+ * Permission to use, modify and distribute this software is
+ * granted provided that this copyright notice appears in all
+ * copies, in source code or in binaries. For precise terms
+ * see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any
+ * kind, express or implied, and with no claim as to its
+ * suitability for any purpose.
+ *
+ */
+
+#ifndef __BB_KERNEL_H__
+#define __BB_KERNEL_H__
+
+#include "bbtypes.h"
+#include "config.h"
+
+/////////////////////////////////
+//
+// class BBKernel
+// (vectorized kernels for bulk operations on arrays of bitblocks)
+//
+// The best instruction set supported by the CPU is selected once at startup (CPUID).
+// Kernels are reached through function pointers which default to the scalar
+// implementation, so they are safe to use during static initialization
+//
+///////////////////////////////////
+
+class BBKernel{
+private:
+	BBKernel(){};
+
+public:
+	enum isa_t {SCALAR, SSE2, AVX2, AVX512};												//instruction sets, in increasing order of preference
+
+	typedef void (*binop_t)	(BITBOARD* res, const BITBOARD* lhs, const BITBOARD* rhs, int nBB);
+	typedef void (*unop_t)	(BITBOARD* res, const BITBOARD* lhs, int nBB);
+	typedef int  (*popc_t)	(const BITBOARD* lhs, int nBB);
+	typedef int  (*popop_t)	(const BITBOARD* lhs, const BITBOARD* rhs, int nBB);
+	typedef int  (*decode_t)(const BITBOARD* lhs, int nBB, int offset, int* out, int max);
+	typedef void (*transp_t)(BITBOARD* a);
+
+	static int init					();														//selects the best supported instruction set (called at startup)
+	static int set_isa				(isa_t);												//forces an instruction set (-1 if not supported by the CPU)
+	static isa_t get_isa			()			{return m_isa;}
+	static bool is_supported		(isa_t);
+	static const char* isa_name		(isa_t);
+	static bool has_vpopcnt			();														//AVX-512 VPOPCNTQ support
+
+//////////////////////
+// kernels: res[i]=lhs[i] op rhs[i] for i in [0, nBB[ (res may be aliased with lhs or rhs)
+
+	static binop_t	bb_and;
+	static binop_t	bb_or;
+	static binop_t	bb_xor;
+	static binop_t	bb_andnot;																//lhs & ~rhs
+	static unop_t	bb_not;
+
+//////////////////////
+// population count kernels: |lhs op rhs| in [0, nBB[ without materializing the result
+// (Harley-Seal carry-save adders on AVX2, VPOPCNTQ on AVX-512 when available)
+
+	static popc_t	bb_popc;
+	static popop_t	bb_popc_and;
+	static popop_t	bb_popc_or;
+	static popop_t	bb_popc_xor;
+	static popop_t	bb_popc_andnot;															//|lhs & ~rhs|
+
+//////////////////////
+// decoding kernel: writes the (increasing) indexes of the 1-bits in [0, nBB[, plus offset, to out
+// Returns the number of indexes written (at most max)
+// (VPCOMPRESSD on AVX-512, byte lookup table expansion on AVX2)
+
+	static decode_t	bb_decode;
+
+//////////////////////
+// transpose kernel: in place transpose of a 64x64 bit block (bit j of a[i] <-> bit i of a[j])
+// (6 mask-and-shift stages, 2 or 4 rows per operation with SSE2/AVX2)
+
+	static transp_t	bb_transpose64;
+
+private:
+	static isa_t m_isa;
+};
+
+#endif
@@ -0,0 +1,85 @@
+// bbmatrix.cpp: implementation of the BitMatrix class, bit matrices in a contiguous slab
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "bbmatrix.h"
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+
+BitMatrix::BitMatrix(int nrows, int ncols, BBAlloc& alloc):m_aBB(NULL), m_nrows(0), m_ncols(0), m_stride(0), m_alloc(&alloc){
+	init(nrows, ncols);
+}
+
+int BitMatrix::init(int nrows, int ncols){
+////////////////
+// one allocation for all the rows, each padded to whole cache lines
+
+	clear();
+
+	const int line=_MEM_ALIGNMENT/sizeof(BITBOARD);							//bitblocks per cache line
+	int nBB=INDEX_1TO1(ncols);
+	m_stride=((nBB+line-1)/line)*line;
+	if(!(m_aBB=m_alloc->allocate((size_t)nrows*m_stride))){					//may exceed the range of int
+		cerr<<"Error when allocating memory: BitMatrix::init"<<endl;
+		m_stride=0;
+		return -1;
+	}
+	m_nrows=nrows;
+	m_ncols=ncols;
+	erase_bit();
+
+	m_rows.reserve(nrows);
+	for(int i=0; i<nrows; i++)
+		m_rows.push_back(BBIntrinView(m_aBB+(size_t)i*m_stride, nBB));
+return 0;
+}
+
+void BitMatrix::clear(){
+	m_rows.clear();
+	if(m_aBB)
+		m_alloc->deallocate(m_aBB, (size_t)m_nrows*m_stride);
+	m_aBB=NULL;
+	m_nrows=0;
+	m_ncols=0;
+	m_stride=0;
+}
+
+void BitMatrix::erase_bit(){
+	if(m_aBB) memset(m_aBB, 0, memory_bytes());									//padding included
+}
+
+int BitMatrix::transpose(BitMatrix& res) const{
+	if(res.init(m_ncols, m_nrows)==-1) return -1;
+
+	vector<const BITBOARD*> src(m_nrows);
+	vector<BITBOARD*> dst(m_ncols);
+	for(int i=0; i<m_nrows; i++) src[i]=m_aBB+(size_t)i*m_stride;
+	for(int i=0; i<m_ncols; i++) dst[i]=res.m_aBB+(size_t)i*res.m_stride;
+	if(m_nrows && m_ncols)
+		transpose(&src[0], m_nrows, m_ncols, &dst[0]);
+return 0;
+}
+
+void BitMatrix::transpose(const BITBOARD* const* src, int nrows, int ncols, BITBOARD* const* dst){
+////////////////
+// tile (bi, bj) of the source is block bj of rows [64*bi, 64*bi+64[: once transposed,
+// its rows are block bi of rows [64*bj, 64*bj+64[ of the destination (rows out of range are 0)
+
+	BITBOARD tile[64];
+	const int nbi=INDEX_1TO1(nrows), nbj=INDEX_1TO1(ncols);
+	for(int bi=0; bi<nbi; bi++){
+		const int nr=min(64, nrows-WMUL(bi));
+		for(int bj=0; bj<nbj; bj++){
+			for(int r=0; r<nr; r++) tile[r]=src[WMUL(bi)+r][bj];
+			for(int r=nr; r<64; r++) tile[r]=ZERO;
+
+			BBKernel::bb_transpose64(tile);
+
+			const int nc=min(64, ncols-WMUL(bj));
+			for(int c=0; c<nc; c++) dst[WMUL(bj)+c][bi]=tile[c];
+		}
+	}
+}
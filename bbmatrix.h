@@ -0,0 +1,116 @@
+/*
+ * bbmatrix.h file from the BITSCAN library, a C++ library for bit set
+ * optimization. BITSCAN has been used to implement BBMC, a very
+ * succesful bit-parallel algorithm for exact maximum clique.
+ * (see license file for references)
+ *
+ * Copyright (C)
+ * Author: Pablo San Segundo
+ * Intelligent Control Research Group (CSIC-UPM)
+ *
+ * Permission to use, modify and distribute this software is
+ * granted provided that this copyright notice appears in all
+ * copies, in source code or in binaries. For precise terms
+ * see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any
+ * kind, express or implied, and with no claim as to its
+ * suitability for any purpose.
+ *
+ */
+
+#ifndef __BB_MATRIX_H__
+#define __BB_MATRIX_H__
+
+#include "bbintrinsic.h"
+#include "bbsentinel.h"
+#include "bballoc.h"
+#include <vector>
+
+using namespace std;
+
+/////////////////////////////////
+//
+// class BitMatrix
+// (bit matrix, e.g. the adjacency matrix of a graph, in a single contiguous slab)
+//
+// All the rows are carved from one allocation (by default cache aligned). Each row is padded
+// to whole cache lines (stride) so rows never share a line, and is handed out as a non-owning
+// BBIntrin view with the full scanning and set algebra API. BBSentinel views (with their
+// own sentinels) may be built on demand.
+// Views must not be used after the matrix is destroyed or reinitialized
+//
+///////////////////////////////////
+
+class BitMatrix{
+public:
+	BitMatrix						():m_aBB(NULL), m_nrows(0), m_ncols(0), m_stride(0), m_alloc(BBAlloc::get_default()){}
+	BitMatrix						(int nrows, int ncols, BBAlloc& alloc=*BBAlloc::get_default());
+	~BitMatrix						()	{clear();}
+
+	int init						(int nrows, int ncols);										//all bits to 0, RETURNS -1 if memory could not be allocated
+	void clear						();
+
+/////////////////////
+// setters and getters
+	int number_of_rows				()				const	{return m_nrows;}
+	int number_of_cols				()				const	{return m_ncols;}
+	int stride						()				const	{return m_stride;}					//bitblocks between consecutive rows
+	BITBOARD* get_slab				()						{return m_aBB;}
+	const BITBOARD* get_slab		()				const	{return m_aBB;}
+
+	BBIntrinView& row				(int i)					{return m_rows[i];}			//fixed size (see BBIntrinView)
+	const BBIntrinView& row			(int i)			const	{return m_rows[i];}
+	BBIntrinView& operator []		(int i)					{return m_rows[i];}
+	const BBIntrinView& operator []	(int i)			const	{return m_rows[i];}
+	BBSentinelView sentinel_row		(int i)					{return BBSentinelView(m_aBB+(size_t)i*m_stride, INDEX_1TO1(m_ncols));}
+
+/////////////////////
+// bits
+	bool is_bit						(int i, int j)	const	{return (m_aBB[(size_t)i*m_stride+WDIV(j)] & Tables::mask[WMOD(j)]);}
+	void set_bit					(int i, int j)			{m_aBB[(size_t)i*m_stride+WDIV(j)] |= Tables::mask[WMOD(j)];}
+	void erase_bit					(int i, int j)			{m_aBB[(size_t)i*m_stride+WDIV(j)] &= ~Tables::mask[WMOD(j)];}
+	void erase_bit					();																//all bits to 0
+	void set_symmetric				(int i, int j)			{set_bit(i, j); set_bit(j, i);}		//edge of an undirected graph
+
+	size_t memory_bytes				()				const	{return (size_t)m_nrows*m_stride*sizeof(BITBOARD);}
+
+/////////////////////
+// transposition (by 64x64 tiles, see BBKernel::bb_transpose64)
+	int transpose					(BitMatrix& res)	const;									//res is reinitialized to ncols x nrows
+	static void transpose			(const BITBOARD* const* src, int nrows, int ncols, BITBOARD* const* dst);	//dst rows have INDEX_1TO1(nrows) bitblocks
+template<class BB>
+	static void transpose			(const vector<BB>& src, int ncols, vector<BB>& res);		//rows of any dense bit string type
+
+private:
+	BitMatrix(const BitMatrix&);
+	BitMatrix& operator=(const BitMatrix&);
+
+	BITBOARD* m_aBB;																			//slab
+	int m_nrows;
+	int m_ncols;
+	int m_stride;
+	BBAlloc* m_alloc;
+	vector<BBIntrinView> m_rows;
+};
+
+///////////////////////
+//
+// TEMPLATE FUNCTIONS
+//
+////////////////////////
+
+template<class BB>
+void BitMatrix::transpose(const vector<BB>& src, int ncols, vector<BB>& res){
+	const int nrows=src.size();
+	res.assign(ncols, BB(nrows));
+
+	vector<const BITBOARD*> s(nrows);
+	vector<BITBOARD*> d(ncols);
+	for(int i=0; i<nrows; i++) s[i]=src[i].get_bitstring();
+	for(int i=0; i<ncols; i++) d[i]=res[i].get_bitstring();
+	if(nrows && ncols)
+		transpose(&s[0], nrows, ncols, &d[0]);
+}
+
+#endif
@@ -0,0 +1,254 @@
+// bbmc.cpp: implementation of the BBMC class, bit-parallel exact maximum clique
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "bbmc.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <algorithm>
+
+using namespace std;
+
+int BBMC::init(const BitMatrix& g){
+////////////////
+// the graph is renumbered so that the vertex at position i of the search is m_order[i]
+
+	if(g.number_of_rows()!=g.number_of_cols()){
+		cerr<<"the adjacency matrix is not square: BBMC::init"<<endl;
+		return -1;
+	}
+
+	m_n=g.number_of_rows();
+	m_width=degeneracy_ordering(g, m_order);
+	reverse(m_order.begin(), m_order.end());						//last vertex removed first
+	m_nsteps=0;
+	m_clique.clear();
+	m_best.clear();
+	m_clique_out.clear();
+	m_P.clear();
+	m_L.clear();
+	m_C.clear();
+	if(m_n==0){
+		m_g.clear();
+		return 0;
+	}
+
+	if(m_g.init(m_n, m_n)==-1) return -1;
+	vector<int> pos(m_n);
+	for(int i=0; i<m_n; i++) pos[m_order[i]]=i;
+	for(int i=0; i<m_n; i++){
+		for(int w : g[m_order[i]].bits())
+			m_g.set_bit(i, pos[w]);
+	}
+
+	//search stack (a clique has at most width+1 vertices)
+	const int nlevels=m_width+2;
+	m_P.assign(nlevels, BBSentinel(m_n));
+	for(int i=0; i<nlevels; i++) m_P[i].set_tracking();
+	m_L.assign(nlevels, vector<int>());
+	m_C.assign(nlevels, vector<int>());
+	m_U=BBSentinel(m_n);
+	m_U.set_tracking();
+	m_Q=BBSentinel(m_n);
+return 0;
+}
+
+int BBMC::set_scan(BBObject::scan_types sct){
+	if(sct!=BBObject::DESTRUCTIVE && sct!=BBObject::NON_DESTRUCTIVE){
+		cerr<<"bad scan type: color classes are scanned in increasing order"<<endl;
+		return -1;
+	}
+	m_scan=sct;
+return 0;
+}
+
+int BBMC::search(){
+	m_nsteps=0;
+	m_clique.clear();
+	m_best.clear();
+	m_clique_out.clear();
+	if(m_n==0) return 0;
+
+	m_P[0].set_bit(0, m_n-1);
+	m_P[0].init_sentinels(false);
+	expand(0);
+
+	for(int i=0; i<m_best.size(); i++)
+		m_clique_out.push_back(m_order[m_best[i]]);
+	sort(m_clique_out.begin(), m_clique_out.end());
+return m_best.size();
+}
+
+void BBMC::expand(int depth){
+////////////////
+// m_clique has depth vertices, all of them adjacent to the candidates m_P[depth] (non empty)
+
+	m_nsteps++;
+	BBSentinel& P=m_P[depth];
+	color(depth, (int)m_best.size()-(int)m_clique.size()+1);
+
+	const vector<int>& L=m_L[depth];
+	const vector<int>& C=m_C[depth];
+	for(int k=L.size()-1; k>=0; k--){
+		if(m_clique.size()+C[k]<=m_best.size()) return;			//color bound
+
+		const int v=L[k];
+		m_clique.push_back(v);
+		BBSentinel& newP=m_P[depth+1];
+		AND(m_g[v], P, newP);										//fits the sentinels of newP
+		if(newP.is_empty()){
+			if(m_clique.size()>m_best.size()) m_best=m_clique;
+		}else{
+			expand(depth+1);
+		}
+		m_clique.pop_back();
+		P.erase_bit(v);
+	}
+}
+
+void BBMC::color(int depth, int kmin){
+////////////////
+// sequential greedy coloring: each color class is a maximal independent set of the
+// uncolored candidates, built in increasing vertex order
+
+	vector<int>& L=m_L[depth];
+	vector<int>& C=m_C[depth];
+	L.clear();
+	C.clear();
+
+	copy_range(m_P[depth], m_U);
+	int v;
+	for(int k=1; !m_U.is_empty(); k++){
+		copy_range(m_U, m_Q);
+		if(m_scan==BBObject::DESTRUCTIVE){
+			m_Q.init_scan(BBObject::DESTRUCTIVE);
+			while((v=m_Q.next_bit_del())!=EMPTY_ELEM){
+				m_U.erase_bit(v);
+				m_Q.erase_bit(m_g[v]);
+				if(k>=kmin){
+					L.push_back(v);
+					C.push_back(k);
+				}
+			}
+		}else{
+			m_Q.init_scan(BBObject::NON_DESTRUCTIVE);
+			while((v=m_Q.next_bit())!=EMPTY_ELEM){
+				m_U.erase_bit(v);
+				m_Q.erase_bit(m_g[v]);								//only vertices after v
+				if(k>=kmin){
+					L.push_back(v);
+					C.push_back(k);
+				}
+			}
+		}
+	}
+}
+
+void BBMC::copy_range(const BBSentinel& from, BBSentinel& to){
+	const int bbl=from.get_sentinel_L(), bbh=from.get_sentinel_H();
+	if(bbl==EMPTY_ELEM || bbh==EMPTY_ELEM){
+		to.clear_sentinels();
+		return;
+	}
+
+	const BITBOARD* src=from.get_bitstring();
+	BITBOARD* dst=to.get_bitstring();
+	for(int i=bbl; i<=bbh; i++)
+		dst[i]=src[i];
+	to.set_sentinels(bbl, bbh);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Graph utilities
+//////////////////////////////////////////////////////////////////////
+
+int BBMC::degeneracy_ordering(const BitMatrix& g, vector<int>& order){
+////////////////
+// repeatedly removes a vertex of minimum degree (the lowest such vertex): the degeneracy is
+// the maximum degree of a vertex when removed
+
+	const int n=g.number_of_rows();
+	order.clear();
+	if(n==0) return 0;
+
+	vector<int> deg(n);
+	BBIntrin alive(n);
+	for(int i=0; i<n; i++){
+		deg[i]=g[i].popcn64();
+		alive.set_bit(i);
+	}
+
+	int width=0;
+	for(int k=0; k<n; k++){
+		int v=EMPTY_ELEM;
+		for(int i : alive.bits()){
+			if(v==EMPTY_ELEM || deg[i]<deg[v]) v=i;
+		}
+		width=max(width, deg[v]);
+		order.push_back(v);
+		alive.erase_bit(v);
+		for(int w : g[v].bits()){
+			if(alive.is_bit(w)) deg[w]--;
+		}
+	}
+return width;
+}
+
+bool BBMC::is_clique(const BitMatrix& g, const vector<int>& vertices){
+	for(int i=0; i<vertices.size(); i++){
+		if(vertices[i]<0 || vertices[i]>=g.number_of_rows()) return false;
+		for(int j=i+1; j<vertices.size(); j++){
+			if(!g.is_bit(vertices[i], vertices[j])) return false;
+		}
+	}
+return true;
+}
+
+int BBMC::read_dimacs(const char* filename, BitMatrix& g){
+	ifstream f(filename);
+	if(!f){
+		cerr<<"Error when opening "<<filename<<": BBMC::read_dimacs"<<endl;
+		return -1;
+	}
+return read_dimacs(f, g);
+}
+
+int BBMC::read_dimacs(istream& in, BitMatrix& g){
+////////////////
+// DIMACS graph format: comments (c), one problem line (p edge n m) and 1-based edges (e u v).
+// Self-loops and other lines are ignored
+
+	string line;
+	int n=EMPTY_ELEM;
+	while(getline(in, line)){
+		if(line.empty()) continue;
+		istringstream fields(line.substr(1));
+		if(line[0]=='p'){
+			string format;
+			int m;
+			if(!(fields>>format>>n>>m) || n<=0){
+				cerr<<"bad problem line: BBMC::read_dimacs"<<endl;
+				return -1;
+			}
+			if(g.init(n, n)==-1) return -1;
+		}else if(line[0]=='e'){
+			int u, v;
+			if(n==EMPTY_ELEM){
+				cerr<<"edge before the problem line: BBMC::read_dimacs"<<endl;
+				return -1;
+			}
+			if(!(fields>>u>>v) || u<1 || u>n || v<1 || v>n){
+				cerr<<"bad edge "<<line<<": BBMC::read_dimacs"<<endl;
+				return -1;
+			}
+			if(u!=v) g.set_symmetric(u-1, v-1);
+		}
+	}
+
+	if(n==EMPTY_ELEM){
+		cerr<<"missing problem line: BBMC::read_dimacs"<<endl;
+		return -1;
+	}
+return 0;
+}
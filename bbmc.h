@@ -0,0 +1,97 @@
+/*
+ * bbmc.h file from the BITSCAN library, a C++ library for bit set
+ * optimization. BITSCAN has been used to implement BBMC, a very
+ * succesful bit-parallel algorithm for exact maximum clique.
+ * (see license file for references)
+ *
+ * Copyright (C)
+ * Author: Pablo San Segundo
+ * Intelligent Control Research Group (CSIC-UPM)
+ *
+ * Permission to use, modify and distribute this software is
+ * granted provided that this copyright notice appears in all
+ * copies, in source code or in binaries. For precise terms
+ * see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any
+ * kind, express or implied, and with no claim as to its
+ * suitability for any purpose.
+ *
+ */
+
+#ifndef __BB_MC_H__
+#define __BB_MC_H__
+
+#include "bbsentinel.h"
+#include "bbmatrix.h"
+#include <vector>
+#include <iostream>
+
+using namespace std;
+
+/////////////////////////////////
+//
+// class BBMC
+// (reference implementation of BBMC, the bit-parallel exact maximum clique algorithm)
+//
+// init() renumbers the vertices by a minimum width (degeneracy) ordering, the last vertex removed
+// first. search() is a branch and bound over BBSentinel candidate sets (in tracking mode, one
+// per level): candidates are colored greedily by bitset color classes (the classes are built
+// with destructive or non destructive scans, see set_scan) and the vertices are expanded from
+// the highest color down, pruning as soon as the color bound cannot improve the best clique.
+// Only vertices with a color which may improve the best clique are stored (BBMC-R).
+//
+// Graphs are symmetric BitMatrix objects with an empty diagonal (see read_dimacs)
+//
+///////////////////////////////////
+
+class BBMC{
+public:
+	BBMC							():m_n(0), m_width(0), m_scan(BBObject::DESTRUCTIVE), m_nsteps(0){}
+
+	int init						(const BitMatrix& g);									//RETURNS -1 if g is not square or memory could not be allocated
+	int set_scan					(BBObject::scan_types);									//DESTRUCTIVE (DEFAULT) or NON_DESTRUCTIVE color classes, -1 otherwise
+	int search						();														//RETURNS the size of a maximum clique
+
+/////////////////////
+// setters and getters
+	int number_of_vertices			()				const	{return m_n;}
+	const vector<int>& clique		()				const	{return m_clique_out;}			//maximum clique of the last search (increasing vertices of the input graph)
+	long long number_of_steps		()				const	{return m_nsteps;}				//nodes of the search tree
+	int width						()				const	{return m_width;}				//degeneracy of the graph
+	const vector<int>& ordering		()				const	{return m_order;}				//vertex of the input graph at each position of the search
+
+/////////////////////
+// graph utilities
+	static int degeneracy_ordering	(const BitMatrix& g, vector<int>& order);				//order[i]: i-th vertex removed by minimum degree, RETURNS the degeneracy
+	static bool is_clique			(const BitMatrix& g, const vector<int>& vertices);
+	static int read_dimacs			(const char* filename, BitMatrix& g);					//RETURNS -1 if the file cannot be read or is ill-formed
+	static int read_dimacs			(istream& , BitMatrix& g);
+
+private:
+	BBMC(const BBMC&);
+	BBMC& operator=(const BBMC&);
+
+	void expand						(int depth);
+	void color						(int depth, int kmin);									//stores the vertices with color >= kmin (and their colors) of level depth
+	static void copy_range			(const BBSentinel& from, BBSentinel& to);				//bitblocks and sentinels in the sentinel range of from
+
+	int m_n;
+	int m_width;
+	int m_scan;
+	long long m_nsteps;
+	BitMatrix m_g;																			//input graph renumbered by m_order
+	vector<int> m_order;
+
+	//search stack
+	vector<BBSentinel> m_P;																	//candidate set of each level
+	vector< vector<int> > m_L;																//vertices to expand of each level, in increasing color
+	vector< vector<int> > m_C;																//their colors
+	BBSentinel m_U;																			//coloring: uncolored candidates
+	BBSentinel m_Q;																			//coloring: candidates for the current color
+	vector<int> m_clique;
+	vector<int> m_best;
+	vector<int> m_clique_out;
+};
+
+#endif
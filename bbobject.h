@@ -24,12 +24,20 @@
 #define  __BB_OBJECT_H__
 
 #include <iostream>
+#include "tables.h"					//MASK_LIM
 using namespace std;
 
 
 class BBObject{
 public:
 	enum scan_types	{NON_DESTRUCTIVE, NON_DESTRUCTIVE_REVERSE, DESTRUCTIVE, DESTRUCTIVE_REVERSE};				//types of bit scans
+	
+	struct scan_cursor{																						//scanning state, may be kept outside the bit string 
+		scan_cursor():bbi(EMPTY_ELEM), pos(MASK_LIM){}
+		int bbi;	//bitblock index (position in the collection for sparse bit strings)
+		int pos;	//bit position for bitscan
+	};
+
 	friend ostream& operator<<(ostream& o , const BBObject& bb){bb.print(o); return o;}
 
 protected:
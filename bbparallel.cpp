@@ -0,0 +1,177 @@
+// bbparallel.cpp: implementation of the BBParallel class, multithreaded bulk operations for dense bit strings
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "bbparallel.h"
+#include <atomic>
+
+using namespace std;
+
+static const int CANCEL_STEP=1024;						//bitblocks scanned between checks of the cancellation flag
+
+//////////////////////////////////////////////////////////////////////
+// Reductions
+//////////////////////////////////////////////////////////////////////
+
+int BBParallel::popcn64(const BitBoardN& bbn, BBThreadPool& pool){
+	const BITBOARD* aBB=bbn.get_bitstring();
+	const int nBB=bbn.number_of_bitblocks();
+	if(!is_parallel(nBB)) return BBKernel::bb_popc(aBB, nBB);
+
+	atomic<int> pc(0);
+	pool.run(nBB, PARALLEL_GRAIN, [&](int begin, int end){
+		pc+=BBKernel::bb_popc(aBB+begin, end-begin);
+	});
+return pc;
+}
+
+int BBParallel::popcount_and(const BitBoardN& lhs, const BitBoardN& rhs, BBThreadPool& pool){
+	const BITBOARD* l=lhs.get_bitstring();
+	const BITBOARD* r=rhs.get_bitstring();
+	const int nBB=lhs.number_of_bitblocks();
+	if(!is_parallel(nBB)) return BBKernel::bb_popc_and(l, r, nBB);
+
+	atomic<int> pc(0);
+	pool.run(nBB, PARALLEL_GRAIN, [&](int begin, int end){
+		pc+=BBKernel::bb_popc_and(l+begin, r+begin, end-begin);
+	});
+return pc;
+}
+
+bool BBParallel::is_empty(const BitBoardN& bbn, BBThreadPool& pool){
+////////////////
+// the first task which finds a 1-bit cancels the rest
+
+	const BITBOARD* aBB=bbn.get_bitstring();
+	const int nBB=bbn.number_of_bitblocks();
+	if(!is_parallel(nBB)) return bbn.is_empty();
+
+	atomic<bool> found(false);
+	pool.run(nBB, PARALLEL_GRAIN, [&](int begin, int end){
+		for(int i=begin; i<end && !found.load(memory_order_relaxed); i+=CANCEL_STEP){
+			BITBOARD acc=ZERO;
+			for(int j=i, last=min(i+CANCEL_STEP, end); j<last; j++)
+				acc|=aBB[j];
+			if(acc){
+				found=true;
+				return;
+			}
+		}
+	});
+return !found;
+}
+
+bool BBParallel::is_disjoint(const BitBoardN& lhs, const BitBoardN& rhs, BBThreadPool& pool){
+	const BITBOARD* l=lhs.get_bitstring();
+	const BITBOARD* r=rhs.get_bitstring();
+	const int nBB=lhs.number_of_bitblocks();
+	if(!is_parallel(nBB)) return lhs.is_disjoint(rhs);
+
+	atomic<bool> found(false);
+	pool.run(nBB, PARALLEL_GRAIN, [&](int begin, int end){
+		for(int i=begin; i<end && !found.load(memory_order_relaxed); i+=CANCEL_STEP){
+			BITBOARD acc=ZERO;
+			for(int j=i, last=min(i+CANCEL_STEP, end); j<last; j++)
+				acc|=l[j] & r[j];
+			if(acc){
+				found=true;
+				return;
+			}
+		}
+	});
+return !found;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Set operations
+//////////////////////////////////////////////////////////////////////
+
+BitBoardN& BBParallel::binop(BBKernel::binop_t op, const BitBoardN& lhs, const BitBoardN& rhs, BitBoardN& res, BBThreadPool& pool){
+	const BITBOARD* l=lhs.get_bitstring();
+	const BITBOARD* r=rhs.get_bitstring();
+	BITBOARD* d=res.get_bitstring();
+	const int nBB=lhs.number_of_bitblocks();
+	if(!is_parallel(nBB)){
+		op(d, l, r, nBB);
+		return res;
+	}
+
+	pool.run(nBB, PARALLEL_GRAIN, [&](int begin, int end){
+		op(d+begin, l+begin, r+begin, end-begin);
+	});
+return res;
+}
+
+BitBoardN& BBParallel::AND(const BitBoardN& lhs, const BitBoardN& rhs, BitBoardN& res, BBThreadPool& pool){
+	return binop(BBKernel::bb_and, lhs, rhs, res, pool);
+}
+
+BitBoardN& BBParallel::OR(const BitBoardN& lhs, const BitBoardN& rhs, BitBoardN& res, BBThreadPool& pool){
+	return binop(BBKernel::bb_or, lhs, rhs, res, pool);
+}
+
+BitBoardN& BBParallel::ERASE(const BitBoardN& lhs, const BitBoardN& rhs, BitBoardN& res, BBThreadPool& pool){
+	return binop(BBKernel::bb_andnot, lhs, rhs, res, pool);
+}
+
+BitBoardN& BBParallel::flip(BitBoardN& bbn, BBThreadPool& pool){
+	BITBOARD* aBB=bbn.get_bitstring();
+	const int nBB=bbn.number_of_bitblocks();
+	if(!is_parallel(nBB)) return bbn.flip();
+
+	pool.run(nBB, PARALLEL_GRAIN, [&](int begin, int end){
+		BBKernel::bb_not(aBB+begin, aBB+begin, end-begin);
+	});
+return bbn;
+}
+
+void BBParallel::erase_bit(BitBoardN& bbn, BBThreadPool& pool){
+	BITBOARD* aBB=bbn.get_bitstring();
+	const int nBB=bbn.number_of_bitblocks();
+	if(!is_parallel(nBB)){
+		bbn.erase_bit();
+		return;
+	}
+
+	pool.run(nBB, PARALLEL_GRAIN, [&](int begin, int end){
+		fill(aBB+begin, aBB+end, ZERO);
+	});
+}
+
+//////////////////////////////////////////////////////////////////////
+// Popcount balanced partitions
+//////////////////////////////////////////////////////////////////////
+
+template<class Popc>
+static void balance(int first, int last, int nparts, Popc popc, vector<int>& bounds){
+////////////////
+// cuts [first, last[ whenever the running popcount reaches the next multiple of total/nparts
+// (ranges are never empty of 1-bits, so there are at most min(nparts, total) of them)
+
+	bounds.clear();
+	long long total=0;
+	for(int i=first; i<last; i++) total+=popc(i);
+	if(total==0) return;
+	if(nparts<1) nparts=1;
+
+	bounds.push_back(first);
+	long long acc=0;
+	int k=1;
+	for(int i=first; i<last && k<nparts; i++){
+		acc+=popc(i);
+		if(acc==total) break;
+		if(acc*nparts>=total*k){
+			bounds.push_back(i+1);
+			while(k<nparts && acc*nparts>=total*k) k++;
+		}
+	}
+	bounds.push_back(last);
+}
+
+void BBParallel::partition(const BITBOARD* aBB, int first_block, int last_block, int nparts, vector<int>& bounds){
+	balance(first_block, last_block, nparts, [aBB](int i){return BitBoard::popc64(aBB[i]);}, bounds);
+}
+
+void BBParallel::partition(const BitBoardS& bbs, int nparts, vector<int>& bounds){
+	balance(0, bbs.number_of_bitblocks(), nparts, [&bbs](int i){return BitBoard::popc64(bbs.get_bitboard(i));}, bounds);
+}
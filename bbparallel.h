@@ -0,0 +1,157 @@
+/*
+ * bbparallel.h file from the BITSCAN library, a C++ library for bit set
+ * optimization. BITSCAN has been used to implement BBMC, a very
+ * succesful bit-parallel algorithm for exact maximum clique.
+ * (see license file for references)
+ *
+ * Copyright (C)
+ * Author: Pablo San Segundo
+ * Intelligent Control Research Group (CSIC-UPM)
+ *
+ * Permission to use, modify and distribute this software is
+ * granted provided that this copyright notice appears in all
+ * copies, in source code or in binaries. For precise terms
+ * see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any
+ * kind, express or implied, and with no claim as to its
+ * suitability for any purpose.
+ *
+ */
+
+#ifndef __BB_PARALLEL_H__
+#define __BB_PARALLEL_H__
+
+#include "bitboardn.h"
+#include "bbintrinsic.h"
+#include "bbsentinel.h"
+#include "bbintrinsic_sparse.h"
+#include "bbthreads.h"
+#include <vector>
+
+/////////////////////////////////
+//
+// class BBParallel
+// (multithreaded bulk operations for very large dense bit strings)
+//
+// Opt-in counterparts of the BitBoardN bulk operations: the bitblocks are split across the
+// threads of a pool (by default BBThreadPool::instance()) and each range is processed by the
+// vectorized kernels (BBKernel). Bit strings with fewer than PARALLEL_MIN_BLOCKS bitblocks
+// (config.h) are processed serially. Boolean reductions (is_empty, is_disjoint) stop all the
+// tasks as soon as the answer is known.
+//
+// for_each_bit(bb, fn) calls fn(bit) for every 1-bit of bb from the threads of the pool. The
+// bitblocks are split into ranges with (roughly) the same number of 1-bits, so clustered
+// populations are balanced, and the ranges are scheduled by work stealing (see
+// BBThreadPool::run_stealing). fn must be safe to call concurrently. In reverse mode each
+// thread takes the highest ranges first and enumerates each range as NON_DESTRUCTIVE_REVERSE.
+//
+// Operands must have the same number of bitblocks
+//
+///////////////////////////////////
+
+class BBParallel{
+private:
+	BBParallel(){};
+
+public:
+	static int popcn64				(const BitBoardN& , BBThreadPool& pool=BBThreadPool::instance());
+	static int popcount_and			(const BitBoardN& lhs, const BitBoardN& rhs, BBThreadPool& pool=BBThreadPool::instance());	//|lhs & rhs|
+
+	static BitBoardN& AND			(const BitBoardN& lhs, const BitBoardN& rhs, BitBoardN& res, BBThreadPool& pool=BBThreadPool::instance());
+	static BitBoardN& OR			(const BitBoardN& lhs, const BitBoardN& rhs, BitBoardN& res, BBThreadPool& pool=BBThreadPool::instance());
+	static BitBoardN& ERASE			(const BitBoardN& lhs, const BitBoardN& rhs, BitBoardN& res, BBThreadPool& pool=BBThreadPool::instance());	//removes rhs from lhs
+	static BitBoardN& flip			(BitBoardN& , BBThreadPool& pool=BBThreadPool::instance());
+	static void erase_bit			(BitBoardN& , BBThreadPool& pool=BBThreadPool::instance());							//all bits to 0
+
+	static bool is_empty			(const BitBoardN& , BBThreadPool& pool=BBThreadPool::instance());
+	static bool is_disjoint			(const BitBoardN& lhs, const BitBoardN& rhs, BBThreadPool& pool=BBThreadPool::instance());
+
+template<class Func>
+	static void for_each_bit		(const BBIntrin& , Func fn, bool reverse=false, BBThreadPool& pool=BBThreadPool::instance());
+template<class Func>
+	static void for_each_bit		(const BBSentinel& , Func fn, bool reverse=false, BBThreadPool& pool=BBThreadPool::instance());		//only the bitblocks between the sentinels
+template<class Func>
+	static void for_each_bit		(const BBIntrinS& , Func fn, bool reverse=false, BBThreadPool& pool=BBThreadPool::instance());
+
+	static bool is_parallel			(int nBB)	{return (nBB>=PARALLEL_MIN_BLOCKS);}
+
+	//popcount balanced partitions: range k is [bounds[k], bounds[k+1][ (bounds is empty if there are no 1-bits)
+	static void partition			(const BITBOARD* aBB, int first_block, int last_block, int nparts, vector<int>& bounds);	//bitblocks [first_block, last_block[
+	static void partition			(const BitBoardS& , int nparts, vector<int>& bounds);									//positions in the collection of bitblocks
+
+private:
+	static BitBoardN& binop			(BBKernel::binop_t op, const BitBoardN& lhs, const BitBoardN& rhs, BitBoardN& res, BBThreadPool& pool);
+template<class Func>
+	static void for_each_dense		(const BITBOARD* aBB, int first_block, int last_block, Func& fn, bool reverse, BBThreadPool& pool);
+};
+
+///////////////////////
+//
+// TEMPLATE FUNCTIONS
+//
+////////////////////////
+
+template<class Func>
+void BBParallel::for_each_bit(const BBIntrin& bb, Func fn, bool reverse, BBThreadPool& pool){
+	for_each_dense(bb.get_bitstring(), 0, bb.number_of_bitblocks(), fn, reverse, pool);
+}
+
+template<class Func>
+void BBParallel::for_each_bit(const BBSentinel& bb, Func fn, bool reverse, BBThreadPool& pool){
+	if(bb.get_sentinel_L()==EMPTY_ELEM) return;
+	for_each_dense(bb.get_bitstring(), bb.get_sentinel_L(), bb.get_sentinel_H()+1, fn, reverse, pool);
+}
+
+template<class Func>
+void BBParallel::for_each_dense(const BITBOARD* aBB, int first_block, int last_block, Func& fn, bool reverse, BBThreadPool& pool){
+	vector<int> bounds;
+	partition(aBB, first_block, last_block, PARALLEL_TASKS*pool.number_of_threads(), bounds);
+	const int ntasks=bounds.empty()? 0 : bounds.size()-1;
+
+	pool.run_stealing(ntasks, [&](int k){
+		if(reverse){
+			k=ntasks-1-k;
+			for(int i=bounds[k+1]-1; i>=bounds[k]; i--){
+				for(BITBOARD bb=aBB[i]; bb; ){
+					int pos=BitBoard::msb64_intrinsic(bb);
+					fn(WMUL(i)+pos);
+					bb^=Tables::mask[pos];
+				}
+			}
+		}else{
+			for(int i=bounds[k]; i<bounds[k+1]; i++){
+				for(BITBOARD bb=aBB[i]; bb; bb&=bb-1)
+					fn(WMUL(i)+BitBoard::lsb64_intrinsic(bb));
+			}
+		}
+	});
+}
+
+template<class Func>
+void BBParallel::for_each_bit(const BBIntrinS& bbs, Func fn, bool reverse, BBThreadPool& pool){
+	vector<int> bounds;
+	partition(bbs, PARALLEL_TASKS*pool.number_of_threads(), bounds);
+	const int ntasks=bounds.empty()? 0 : bounds.size()-1;
+	BitBoardS::velem_cit it=bbs.begin();
+
+	pool.run_stealing(ntasks, [&](int k){
+		if(reverse){
+			k=ntasks-1-k;
+			for(int i=bounds[k+1]-1; i>=bounds[k]; i--){
+				for(BITBOARD bb=it[i].bb; bb; ){
+					int pos=BitBoard::msb64_intrinsic(bb);
+					fn(WMUL(it[i].index)+pos);
+					bb^=Tables::mask[pos];
+				}
+			}
+		}else{
+			for(int i=bounds[k]; i<bounds[k+1]; i++){
+				for(BITBOARD bb=it[i].bb; bb; bb&=bb-1)
+					fn(WMUL(it[i].index)+BitBoard::lsb64_intrinsic(bb));
+			}
+		}
+	});
+}
+
+#endif
@@ -0,0 +1,105 @@
+// bbrank.cpp: implementation of the BBRankSelect class, rank/select directory of dense bit strings
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "bbrank.h"
+#include <algorithm>
+
+using namespace std;
+
+void BBRankSelect::build(const BitBoardN& bbn){
+////////////////
+// one pass over the bitblocks: entries, sentinel entry and select samples
+
+	m_aBB=bbn.get_bitstring();
+	m_nBB=bbn.number_of_bitblocks();
+	if(m_nBB<0) m_nBB=0;
+
+	const int nBlocks=(m_nBB+BLOCK_WORDS-1)/BLOCK_WORDS;
+	m_entry.assign(nBlocks+1, ZERO);
+	m_sample.clear();
+
+	int pc=0, next_sample=0;
+	for(int b=0; b<nBlocks; b++){
+		BITBOARD e=pc;
+		int w=b*BLOCK_WORDS;
+		for(int j=0; j<BLOCK_BITS/BASIC_BITS; j++){
+			int count=0;
+			for(int end=min(w+BASIC_BITS/64, m_nBB); w<end; w++)
+				count+=BitBoard::popc64(m_aBB[w]);
+			if(j<3) e|=(BITBOARD)count<<(32+10*j);
+			pc+=count;
+		}
+		m_entry[b]=e;
+
+		for(; next_sample<pc; next_sample+=SELECT_SAMPLE)
+			m_sample.push_back(b);
+	}
+	m_entry[nBlocks]=pc;
+	m_pc=pc;
+}
+
+void BBRankSelect::clear(){
+	m_aBB=NULL;
+	m_nBB=0;
+	m_pc=0;
+	m_entry.clear();
+	m_sample.clear();
+}
+
+int BBRankSelect::select(int k) const{
+////////////////////
+// sample -> binary search of the entries up to the next sample -> basic blocks -> bitblock
+
+	if(k<0 || k>=m_pc) return EMPTY_ELEM;
+
+	//last block with rank<=k (bounded by the block of the next sample)
+	int s=k/SELECT_SAMPLE;
+	int lo=m_sample[s];
+	int hi=(s+1<m_sample.size())? m_sample[s+1] : m_entry.size()-2;
+	while(lo<hi){
+		int mid=(lo+hi+1)/2;
+		if(rank_block(mid)<=k) lo=mid; else hi=mid-1;
+	}
+	k-=rank_block(lo);
+
+	int j=0;
+	for(; j<3; j++){
+		int count=basic_count(lo, j);
+		if(k<count) break;
+		k-=count;
+	}
+
+	int w=lo*BLOCK_WORDS+j*(BASIC_BITS/64);
+	for(;; w++){
+		int count=BitBoard::popc64(m_aBB[w]);
+		if(k<count) break;
+		k-=count;
+	}
+return WMUL(w)+select64(m_aBB[w], k);
+}
+
+int BBRankSelect::select64(BITBOARD bb, int k){
+////////////////////
+// narrows down to a byte with three popcounts
+
+	int pos=0, count;
+	count=BitBoard::popc64(bb & 0xFFFFFFFFULL);
+	if(k>=count){k-=count; bb>>=32; pos+=32;}
+	count=BitBoard::popc64(bb & 0xFFFFULL);
+	if(k>=count){k-=count; bb>>=16; pos+=16;}
+	count=BitBoard::popc64(bb & 0xFFULL);
+	if(k>=count){k-=count; bb>>=8; pos+=8;}
+
+	for(;; bb>>=1, pos++){
+		if(bb & 1){
+			if(!k) break;
+			k--;
+		}
+	}
+return pos;
+}
+
+size_t BBRankSelect::memory_bytes() const{
+	return m_entry.size()*sizeof(BITBOARD)+m_sample.size()*sizeof(U32);
+}
@@ -0,0 +1,111 @@
+/*
+ * bbrank.h file from the BITSCAN library, a C++ library for bit set
+ * optimization. BITSCAN has been used to implement BBMC, a very
+ * succesful bit-parallel algorithm for exact maximum clique.
+ * (see license file for references)
+ *
+ * Copyright (C)
+ * Author: Pablo San Segundo
+ * Intelligent Control Research Group (CSIC-UPM)
+ *
+ * Permission to use, modify and distribute this software is
+ * granted provided that this copyright notice appears in all
+ * copies, in source code or in binaries. For precise terms
+ * see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any
+ * kind, express or implied, and with no claim as to its
+ * suitability for any purpose.
+ *
+ */
+
+#ifndef __BB_RANK_H__
+#define __BB_RANK_H__
+
+#include "bitboardn.h"
+#include <vector>
+
+using namespace std;
+
+/////////////////////////////////
+//
+// class BBRankSelect
+// (Immutable rank/select directory of a dense bit string, poppy layout)
+//
+// One 64-bit entry per block of 2048 bits: the number of 1-bits before the block (32 bits)
+// and the population of its first three basic blocks of 512 bits (10 bits each). Select
+// samples store the 2048-bit block of every SELECT_SAMPLE-th 1-bit.
+//
+// rank(i) reads one entry and popcounts at most 8 bitblocks; select(k) jumps to the sample,
+// advances over a few entries and resolves the bitblock with a rank search. The overhead is
+// 64 bits per 2048 bits plus 32 bits per SELECT_SAMPLE 1-bits (about 3.5% at most).
+//
+// The directory keeps a pointer to the bitblocks of the bit string: it must be rebuilt
+// (build) whenever the bit string changes
+//
+///////////////////////////////////
+
+class BBRankSelect{
+public:
+	static const int BASIC_BITS=512;											//basic block (8 bitblocks, one cache line)
+	static const int BLOCK_BITS=2048;											//one directory entry (4 basic blocks)
+	static const int BLOCK_WORDS=BLOCK_BITS/64;
+	static const int SELECT_SAMPLE=8192;										//1-bits between select samples
+
+	BBRankSelect					():m_aBB(NULL), m_nBB(0), m_pc(0){}
+explicit BBRankSelect				(const BitBoardN& bbn){build(bbn);}
+
+	void build						(const BitBoardN& );
+	void clear						();
+
+/////////////////////
+// queries (bits are 0 based)
+inline	int rank					(int nBit)		const;						//number of 1-bits in [0, nBit[
+	int select						(int k)			const;						//position of the k-th 1-bit (k 0 based), EMPTY_ELEM if k>=popcn64()
+	int popcn64						()				const	{return m_pc;}
+	int popcn64						(int nBit)		const	{return m_pc-rank(nBit);}	//population from nBit (included) onwards
+
+	size_t memory_bytes				()				const;						//size of the directory
+
+protected:
+inline	int rank_block				(int nBlock)	const	{return (int)(m_entry[nBlock] & 0xFFFFFFFF);}
+inline	int basic_count				(int nBlock, int j)	const	{return (int)((m_entry[nBlock]>>(32+10*j)) & 0x3FF);}	//j<3
+static	int select64				(BITBOARD bb, int k);						//position of the k-th 1-bit of bb (k 0 based, k<popcount)
+
+////////////////////////
+// Member data
+	const BITBOARD* m_aBB;
+	int m_nBB;
+	int m_pc;																	//population
+	vector<BITBOARD> m_entry;													//one entry per 2048 bits (plus a sentinel entry)
+	vector<U32> m_sample;														//block of the 1-bits 0, SELECT_SAMPLE, 2*SELECT_SAMPLE...
+};
+
+///////////////////////
+//
+// INLINE FUNCTIONS
+//
+////////////////////////
+
+inline int BBRankSelect::rank(int nBit) const{
+////////////////////
+// O(1): entry + basic block counts + at most 7 full bitblocks + partial bitblock
+
+	if(nBit<=0) return 0;
+	if(nBit>=WMUL(m_nBB)) return m_pc;
+
+	int nBlock=nBit/BLOCK_BITS;
+	int r=rank_block(nBlock);
+	int basic=(nBit%BLOCK_BITS)/BASIC_BITS;
+	for(int j=0; j<basic; j++)
+		r+=basic_count(nBlock, j);
+
+	int w=nBlock*BLOCK_WORDS+basic*(BASIC_BITS/64);
+	for(; w<WDIV(nBit); w++)
+		r+=BitBoard::popc64(m_aBB[w]);
+	if(WMOD(nBit))
+		r+=BitBoard::popc64(m_aBB[w] & Tables::mask_right[WMOD(nBit)]);
+return r;
+}
+
+#endif
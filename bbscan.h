@@ -0,0 +1,305 @@
+/*
+ * bbscan.h file from the BITSCAN library, a C++ library for bit set
+ * optimization. BITSCAN has been used to implement BBMC, a very
+ * succesful bit-parallel algorithm for exact maximum clique.
+ * (see license file for references)
+ *
+ * Copyright (C)
+ * Author: Pablo San Segundo
+ * Intelligent Control Research Group (CSIC-UPM)
+ *
+ * Permission to use, modify and distribute this software is
+ * granted provided that this copyright notice appears in all
+ * copies, in source code or in binaries. For precise terms
+ * see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any
+ * kind, express or implied, and with no claim as to its
+ * suitability for any purpose.
+ *
+ */
+
+#ifndef __BB_SCAN_H__
+#define __BB_SCAN_H__
+
+#include "bbobject.h"
+#include "bitboard.h"
+
+/////////////////////////////////
+//
+// class BBScan
+// (bitscanning of dense bit strings with static dispatch, CRTP)
+//
+// Single implementation of the scanning hot path. Nothing is virtual so every call
+// inlines into the enumeration loop. Derived classes provide the storage and the
+// scanning state through the following (inline) hooks:
+//
+//	BITBOARD* bitblocks() const	: the bitblocks
+//	int low_block() const		: first bitblock of the scan range
+//	int high_block() const		: last bitblock of the scan range
+//	scan_t& scan_state()		: cursor of non destructive scans (bitblock and bit position)
+//	int& cursor_low()			: cursor of forward destructive scans
+//	int& cursor_high()			: cursor of reverse destructive scans
+//	void prepare_scan()			: called by init_scan before the cursors are set
+//
+// Derived classes may shadow any scan function with a specialized version
+//
+///////////////////////////////////
+
+template<class Derived>
+class BBScan{
+public:
+	typedef BBObject::scan_types scan_types;
+
+	int init_scan						(scan_types);
+
+	//bit scan forward (non destructive)
+	int next_bit						();
+	int next_bit						(int& nBB);
+	template<class BB_t>
+	int next_bit						(int& nBB, BB_t& bb_del);							//also erases the bit in bb_del
+
+	//bit scan forward (destructive)
+	int next_bit_del					();
+	int next_bit_del					(int& nBB);
+	template<class BB_t>
+	int next_bit_del					(int& nBB, BB_t& bb_del);							//also erases the bit in bb_del
+
+	//bit scan backwards
+	int previous_bit					();
+	int previous_bit_del				();
+	int previous_bit_del				(int& nBB);
+	template<class BB_t>
+	int previous_bit_del				(int& nBB, BB_t& bb_del);							//also erases the bit in bb_del
+
+	//in the scan range
+	int lsbn64							()	const;
+	int msbn64							()	const;
+	int popcn64							()	const;
+	bool is_empty						()	const;
+
+protected:
+	Derived& self						()			{return *static_cast<Derived*>(this);}
+	const Derived& self					()	const	{return *static_cast<const Derived*>(this);}
+};
+
+///////////////////////
+//
+// INLINE FUNCTIONS
+//
+////////////////////////
+
+template<class Derived>
+inline int BBScan<Derived>::init_scan(scan_types sct){
+	Derived& d=self();
+	d.prepare_scan();
+	switch(sct){
+	case BBObject::NON_DESTRUCTIVE:
+		d.scan_state().bbi=d.low_block();
+		d.scan_state().pos=MASK_LIM;
+		break;
+	case BBObject::NON_DESTRUCTIVE_REVERSE:
+		d.scan_state().bbi=d.high_block();
+		d.scan_state().pos=WORD_SIZE;		//mask_right[WORD_SIZE]=ONE
+		break;
+	case BBObject::DESTRUCTIVE:
+		d.cursor_low()=d.low_block();
+		break;
+	case BBObject::DESTRUCTIVE_REVERSE:
+		d.cursor_high()=d.high_block();
+		break;
+	default:
+		cerr<<"bad scan type"<<endl;
+		return -1;
+	}
+return 0;
+}
+
+template<class Derived>
+inline int BBScan<Derived>::next_bit(){
+////////////////////////////
+// non destructive: the scan state caches the last bit found
+
+	Derived& d=self();
+	const BITBOARD* aBB=d.bitblocks();
+	unsigned long posInBB;
+
+	//search for next bit in the last block
+	if(_BitScanForward64(&posInBB, aBB[d.scan_state().bbi] & Tables::mask_left[d.scan_state().pos])){
+		d.scan_state().pos=posInBB;
+		return (posInBB + WMUL(d.scan_state().bbi));
+	}else{											//search in the remaining blocks
+		const int bbh=d.high_block();
+		for(int i=d.scan_state().bbi+1; i<=bbh; i++){
+			if(_BitScanForward64(&posInBB,aBB[i])){
+				d.scan_state().bbi=i;
+				d.scan_state().pos=posInBB;
+				return (posInBB+ WMUL(i));
+			}
+		}
+	}
+return EMPTY_ELEM;
+}
+
+template<class Derived>
+inline int BBScan<Derived>::next_bit(int& nBB){
+	int nBit=next_bit();
+	if(nBit!=EMPTY_ELEM) nBB=self().scan_state().bbi;
+return nBit;
+}
+
+template<class Derived> template<class BB_t>
+inline int BBScan<Derived>::next_bit(int& nBB, BB_t& bb_del){
+	int nBit=next_bit();
+	if(nBit!=EMPTY_ELEM){
+		nBB=self().scan_state().bbi;
+		bb_del.get_bitstring()[nBB]&=~Tables::mask[WMOD(nBit)];
+	}
+return nBit;
+}
+
+template<class Derived>
+inline int BBScan<Derived>::next_bit_del(){
+////////////////////////////
+// destructive: erases the bit scanned before returning
+
+	Derived& d=self();
+	BITBOARD* aBB=d.bitblocks();
+	unsigned long posInBB;
+
+	const int bbh=d.high_block();
+	for(int i=d.cursor_low(); i<=bbh; i++){
+		if(_BitScanForward64(&posInBB,aBB[i])){
+			d.cursor_low()=i;
+			aBB[i]&=~Tables::mask[posInBB];
+			return (posInBB+WMUL(i));
+		}
+	}
+return EMPTY_ELEM;
+}
+
+template<class Derived>
+inline int BBScan<Derived>::next_bit_del(int& nBB){
+	int nBit=next_bit_del();
+	if(nBit!=EMPTY_ELEM) nBB=self().cursor_low();
+return nBit;
+}
+
+template<class Derived> template<class BB_t>
+inline int BBScan<Derived>::next_bit_del(int& nBB, BB_t& bb_del){
+	int nBit=next_bit_del();
+	if(nBit!=EMPTY_ELEM){
+		nBB=self().cursor_low();
+		bb_del.get_bitstring()[nBB]&=~Tables::mask[WMOD(nBit)];
+	}
+return nBit;
+}
+
+template<class Derived>
+inline int BBScan<Derived>::previous_bit(){
+////////////////////////////
+// non destructive in reverse order (end-->begin)
+
+	Derived& d=self();
+	const BITBOARD* aBB=d.bitblocks();
+	unsigned long posInBB;
+
+	//search in the last block
+	if(_BitScanReverse64(&posInBB, aBB[d.scan_state().bbi] & Tables::mask_right[d.scan_state().pos])){
+		d.scan_state().pos=posInBB;
+		return (posInBB + WMUL(d.scan_state().bbi));
+	}else{											//search in the remaining blocks
+		const int bbl=d.low_block();
+		for(int i=d.scan_state().bbi-1; i>=bbl; i--){
+			if(_BitScanReverse64(&posInBB,aBB[i])){
+				d.scan_state().bbi=i;
+				d.scan_state().pos=posInBB;
+				return (posInBB+ WMUL(i));
+			}
+		}
+	}
+return EMPTY_ELEM;
+}
+
+template<class Derived>
+inline int BBScan<Derived>::previous_bit_del(){
+	Derived& d=self();
+	BITBOARD* aBB=d.bitblocks();
+	unsigned long posInBB;
+
+	const int bbl=d.low_block();
+	for(int i=d.cursor_high(); i>=bbl; i--){
+		if(_BitScanReverse64(&posInBB,aBB[i])){
+			d.cursor_high()=i;
+			aBB[i]&=~Tables::mask[posInBB];			//erases the bit before returning
+			return (posInBB+WMUL(i));
+		}
+	}
+return EMPTY_ELEM;
+}
+
+template<class Derived>
+inline int BBScan<Derived>::previous_bit_del(int& nBB){
+	int nBit=previous_bit_del();
+	if(nBit!=EMPTY_ELEM) nBB=self().cursor_high();
+return nBit;
+}
+
+template<class Derived> template<class BB_t>
+inline int BBScan<Derived>::previous_bit_del(int& nBB, BB_t& bb_del){
+	int nBit=previous_bit_del();
+	if(nBit!=EMPTY_ELEM){
+		nBB=self().cursor_high();
+		bb_del.get_bitstring()[nBB]&=~Tables::mask[WMOD(nBit)];
+	}
+return nBit;
+}
+
+template<class Derived>
+inline int BBScan<Derived>::lsbn64() const{
+	const Derived& d=self();
+	const BITBOARD* aBB=d.bitblocks();
+	unsigned long posInBB;
+	const int bbh=d.high_block();
+	for(int i=d.low_block(); i<=bbh; i++){
+		if(_BitScanForward64(&posInBB, aBB[i]))
+			return(posInBB+ WMUL(i));
+	}
+return EMPTY_ELEM;
+}
+
+template<class Derived>
+inline int BBScan<Derived>::msbn64() const{
+	const Derived& d=self();
+	const BITBOARD* aBB=d.bitblocks();
+	unsigned long posInBB;
+	const int bbl=d.low_block();
+	for(int i=d.high_block(); i>=bbl; i--){
+		if(_BitScanReverse64(&posInBB, aBB[i]))
+			return (posInBB+WMUL(i));
+	}
+return EMPTY_ELEM;
+}
+
+template<class Derived>
+inline int BBScan<Derived>::popcn64() const{
+	const Derived& d=self();
+	const BITBOARD* aBB=d.bitblocks();
+	int pc=0;
+	const int bbh=d.high_block();
+	for(int i=d.low_block(); i<=bbh; i++)
+		pc+=BitBoard::popc64(aBB[i]);
+return pc;
+}
+
+template<class Derived>
+inline bool BBScan<Derived>::is_empty() const{
+	const Derived& d=self();
+	const BITBOARD* aBB=d.bitblocks();
+	const int bbh=d.high_block();
+	for(int i=d.low_block(); i<=bbh; i++)
+		if(aBB[i]) return false;
+return true;
+}
+
+#endif
@@ -5,8 +5,28 @@
 using namespace std;
 
 BBSentinel&  AND (const BitBoardN& lhs, const BBSentinel& rhs,  BBSentinel& res){
+///////////////
+// AND in the sentinel range of rhs (in tracking mode the sentinels of res are fitted in the same pass)
+
+	if(rhs.m_BBL==EMPTY_ELEM || rhs.m_BBH==EMPTY_ELEM){
+		res.clear_sentinels();
+		return res;
+	}
+
 	res.m_BBL=rhs.m_BBL;
 	res.m_BBH=rhs.m_BBH;
+	if(res.m_track){
+		int bbl=EMPTY_ELEM, bbh=EMPTY_ELEM;
+		for(int i=rhs.m_BBL; i<=rhs.m_BBH; i++){
+			if((res.m_aBB[i]=lhs.get_bitboard(i)&rhs.m_aBB[i])){
+				if(bbl==EMPTY_ELEM) bbl=i;
+				bbh=i;
+			}
+		}
+		res.set_sentinels(bbl, bbh);
+		return res;
+	}
+
 	for(int i=rhs.m_BBL; i<=rhs.m_BBH; i++){
 		res.m_aBB[i]=lhs.get_bitboard(i)&rhs.m_aBB[i];
 	}
@@ -31,6 +51,11 @@ void BBSentinel::clear_sentinels(){
 	m_BBH=EMPTY_ELEM;
 }
 
+void BBSentinel::set_tracking(bool track){
+	if(track && !m_track) init_sentinels(true);
+	m_track=track;
+}
+
 int BBSentinel::update_sentinels(){
 ///////////////
 // Updates sentinels
@@ -160,27 +185,34 @@ void BBSentinel::print(std::ostream& o){
 
 
 int BBSentinel::init_scan(scan_types sct){
-	switch(sct){
-	case NON_DESTRUCTIVE:
-		update_sentinels();
-		m_scan.bbi=m_BBL;
-		m_scan.pos=MASK_LIM; 
-		break;
-	case NON_DESTRUCTIVE_REVERSE:
-		update_sentinels();
-		m_scan.bbi=m_BBH;
-		m_scan.pos=WORD_SIZE;		//mask_right[WORD_SIZE]=ONE
-		break;
-	case DESTRUCTIVE:				//uses sentinels to iterate and updates them on the fly
-		update_sentinels();
-		break;
-	case DESTRUCTIVE_REVERSE:		//uses sentinels to iterate and updates them on the fly
-		update_sentinels();
-		break;
-	default:
-		cerr<<"bad scan type"<<endl;
+//////////////
+// sentinels are updated first: destructive scans use them as cursors and update them on the fly
+
+	return BBSentinelScan(*this).init_scan(sct);
+}
+
+int BBSentinel::init_scan(scan_cursor& sc, scan_types sct) const{
+//////////////
+// the sentinels are not updated (const): they must enclose all 1-bits
+// If the sentinels are empty the cursor is left at the end (scans return EMPTY_ELEM)
+//
+// RETURNS -1 for destructive (or unknown) scan types, 0 otherwise
+
+	if(sct!=NON_DESTRUCTIVE && sct!=NON_DESTRUCTIVE_REVERSE){
+		cerr<<"bad scan type: destructive scans in BBSentinel use the sentinels"<<endl;
 		return -1;
 	}
+
+	if(m_BBL==EMPTY_ELEM || m_BBH==EMPTY_ELEM){
+		sc.bbi=EMPTY_ELEM;
+		sc.pos=EMPTY_ELEM;
+	}else if(sct==NON_DESTRUCTIVE){
+		sc.bbi=m_BBL;
+		sc.pos=MASK_LIM; 
+	}else{
+		sc.bbi=m_BBH;
+		sc.pos=WORD_SIZE;		//mask_right[WORD_SIZE]=ONE
+	}
 return 0;
 }
 
@@ -194,6 +226,23 @@ void  BBSentinel::erase_bit	(){
 
 	for(int i=m_BBL; i<=m_BBH; i++)	
 				m_aBB[i]=ZERO;
+	if(m_track) clear_sentinels();
+}
+
+void BBSentinel::set_bit (const BitBoardN& bb_add){
+////////////////
+// OR (in tracking mode the sentinels are extended to the 1-bits of bb_add)
+
+	BitBoardN::set_bit(bb_add);
+	if(m_track){
+		const BITBOARD* aBB=bb_add.get_bitstring();
+		int i=0;
+		for(; i<m_nBB && !aBB[i]; i++){}
+		if(i==m_nBB) return;								//bb_add is empty
+		update_sentinels_to_v(WMUL(i));
+		for(i=m_nBB-1; !aBB[i]; i--){}
+		update_sentinels_to_v(WMUL(i));
+	}
 }
 
 
@@ -203,7 +252,21 @@ BBSentinel& BBSentinel::erase_bit (const BitBoardN& bbn){
 // 
 // REMARKS:
 // 1.Has to be careful with BitBoardN cast to int in constructor
+// 2.In tracking mode the sentinels are fitted in the same pass
 	
+	if(m_BBL==EMPTY_ELEM || m_BBH==EMPTY_ELEM) return *this;
+	if(m_track){
+		int bbl=EMPTY_ELEM, bbh=EMPTY_ELEM;
+		for(int i=m_BBL; i<=m_BBH; i++){
+			if((m_aBB[i] &= ~ bbn.get_bitboard(i))){
+				if(bbl==EMPTY_ELEM) bbl=i;
+				bbh=i;
+			}
+		}
+		set_sentinels(bbl, bbh);
+		return *this;
+	}
+
 	for(int i=m_BBL; i<=m_BBH; i++)
 		m_aBB[i] &= ~ bbn.get_bitboard(i);		//**access
 
@@ -260,12 +323,50 @@ bool BBSentinel::is_empty (int nBBL, int nBBH) const{
 return true;	
 }
 
+int BBSentinel::popcount_and (const BitBoardN& rhs) const{
+////////////////
+// population of the intersection with rhs in the sentinel range
+	if(m_BBL==EMPTY_ELEM || m_BBH==EMPTY_ELEM) return 0;
+	return BBKernel::bb_popc_and(m_aBB+m_BBL, rhs.get_bitstring()+m_BBL, m_BBH-m_BBL+1);
+}
+
+int BBSentinel::popcount_andnot (const BitBoardN& rhs) const{
+	if(m_BBL==EMPTY_ELEM || m_BBH==EMPTY_ELEM) return 0;
+	return BBKernel::bb_popc_andnot(m_aBB+m_BBL, rhs.get_bitstring()+m_BBL, m_BBH-m_BBL+1);
+}
+
+int BBSentinel::popcount_or (const BitBoardN& rhs) const{
+////////////////
+// blocks outside the sentinel range are considered empty in *this, so only rhs counts there
+	const BITBOARD* prhs=rhs.get_bitstring();
+	if(m_BBL==EMPTY_ELEM || m_BBH==EMPTY_ELEM) return BBKernel::bb_popc(prhs, m_nBB);
+
+	return	BBKernel::bb_popc(prhs, m_BBL) + 
+			BBKernel::bb_popc_or(m_aBB+m_BBL, prhs+m_BBL, m_BBH-m_BBL+1) +
+			BBKernel::bb_popc(prhs+m_BBH+1, m_nBB-m_BBH-1);
+}
+
+int BBSentinel::decode (int* out, int max) const{
+	if(m_BBL==EMPTY_ELEM || m_BBH==EMPTY_ELEM) return 0;
+	return BBKernel::bb_decode(m_aBB+m_BBL, m_BBH-m_BBL+1, WMUL(m_BBL), out, max);
+}
+
+int BBSentinel::popcount_xor (const BitBoardN& rhs) const{
+	const BITBOARD* prhs=rhs.get_bitstring();
+	if(m_BBL==EMPTY_ELEM || m_BBH==EMPTY_ELEM) return BBKernel::bb_popc(prhs, m_nBB);
+
+	return	BBKernel::bb_popc(prhs, m_BBL) + 
+			BBKernel::bb_popc_xor(m_aBB+m_BBL, prhs+m_BBL, m_BBH-m_BBL+1) +
+			BBKernel::bb_popc(prhs+m_BBH+1, m_nBB-m_BBH-1);
+}
+
 BBSentinel& BBSentinel::operator= (const  BBSentinel& bbs){
 ///////////////
 // redefinition of equality: same sentinels of the copied bbs, same bitblocks in sentinel range
 
 	m_BBL=bbs.m_BBL;
 	m_BBH=bbs.m_BBH;
+	m_track=bbs.m_track;
 
 	for(int i=m_BBL; i<=m_BBH; i++){
 		this->m_aBB[i]=bbs.m_aBB[i];
@@ -275,9 +376,47 @@ BBSentinel& BBSentinel::operator= (const  BBSentinel& bbs){
 
 }
 
+BBSentinel& BBSentinel::operator= (BBSentinel&& bbs) noexcept{
+	if(this==&bbs) return *this;
+	BBIntrin::operator=(std::move(bbs));
+	m_BBL=bbs.m_BBL;
+	m_BBH=bbs.m_BBH;
+	m_track=bbs.m_track;
+	bbs.clear_sentinels();
+return *this;
+}
+
+BitBoardN& BBSentinelView::operator= (const BitBoardN& bbN){
+///////////////
+// all the bitblocks are copied (the storage of the view is fixed) and the sentinels fitted
+
+	if(this==&bbN) return *this;
+	if(bbN.number_of_bitblocks()!=m_nBB){
+		cerr<<"bit string of a different size assigned to a view: BBSentinelView"<<endl;
+		return *this;
+	}
+	BitBoardN::operator=(bbN);
+	init_sentinels(true);
+return *this;
+}
+
 BBSentinel& BBSentinel::operator&=	(const  BitBoardN& bbn){
 //////////////////
 // AND operation in the range of the sentinels
+// (in tracking mode the sentinels are fitted in the same pass)
+
+	if(m_BBL==EMPTY_ELEM || m_BBH==EMPTY_ELEM) return *this;
+	if(m_track){
+		int bbl=EMPTY_ELEM, bbh=EMPTY_ELEM;
+		for(int i=m_BBL; i<=m_BBH; i++){
+			if((this->m_aBB[i] &= bbn.get_bitboard(i))){
+				if(bbl==EMPTY_ELEM) bbl=i;
+				bbh=i;
+			}
+		}
+		set_sentinels(bbl, bbh);
+		return *this;
+	}
 
 	for(int i=m_BBL; i<=m_BBH; i++){
 		this->m_aBB[i] &= bbn.get_bitboard(i);
@@ -28,11 +28,14 @@
  using namespace std;
 
 class BBSentinel : public BBIntrin{
+	friend class BBSentinelScan;
 	friend BBSentinel&  AND	(const BitBoardN& lhs, const BBSentinel& rhs,  BBSentinel& res);		//updates sentinels
 public:
-	BBSentinel():m_BBH(EMPTY_ELEM), m_BBL(EMPTY_ELEM){init_sentinels(false);}
-explicit BBSentinel(int popsize, bool bits_to_0=true): BBIntrin(popsize, bits_to_0){ init_sentinels(false);}
-	BBSentinel(const BBSentinel& bbN) : BBIntrin(bbN){ m_BBH=bbN.m_BBH; m_BBL=bbN.m_BBL;}
+	BBSentinel():m_BBH(EMPTY_ELEM), m_BBL(EMPTY_ELEM), m_track(false){init_sentinels(false);}
+explicit BBSentinel(int popsize, bool bits_to_0=true): BBIntrin(popsize, bits_to_0), m_track(false){ init_sentinels(false);}
+	BBSentinel(int popsize, BBAlloc& alloc, bool bits_to_0=true): BBIntrin(popsize, alloc, bits_to_0), m_track(false){ init_sentinels(false);}
+	BBSentinel(const BBSentinel& bbN) : BBIntrin(bbN){ m_BBH=bbN.m_BBH; m_BBL=bbN.m_BBL; m_track=bbN.m_track;}
+	BBSentinel(BBSentinel&& bbN) noexcept : BBIntrin(std::move(bbN)){ m_BBH=bbN.m_BBH; m_BBL=bbN.m_BBL; m_track=bbN.m_track; bbN.clear_sentinels();}
 	~BBSentinel(){};
 
 ////////////
@@ -42,8 +45,12 @@ explicit BBSentinel(int popsize, bool bits_to_0=true): BBIntrin(popsize, bits_to
 	void set_sentinels(int low, int high);
 	void init_sentinels(bool update=false);								//sets sentinels to maximum scope of current bit string
 	void clear_sentinels();												//sentinels to EMPTY
-	int get_sentinel_L(){ return m_BBL;}
-	int get_sentinel_H(){ return m_BBH;}
+	int get_sentinel_L() const{ return m_BBL;}
+	int get_sentinel_H() const{ return m_BBH;}
+
+	//range-for iteration in the sentinel range
+	bit_range bits() const					{return (m_BBL==EMPTY_ELEM)? bit_range(m_aBB, 0, -1) : bit_range(m_aBB, m_BBL, m_BBH);}
+	bit_range_reverse bits_reverse() const	{return (m_BBL==EMPTY_ELEM)? bit_range_reverse(m_aBB, 0, -1) : bit_range_reverse(m_aBB, m_BBL, m_BBH);}
 /////////////
 // basic sentinel
 
@@ -54,12 +61,27 @@ explicit BBSentinel(int popsize, bool bits_to_0=true): BBIntrin(popsize, bits_to
 
 	void update_sentinels_to_v		(int v);	
 
+/////////////
+// tracking mode: set_bit, erase_bit, AND, &= and erase_bit(const BitBoardN&) keep the sentinels exact
+// (setting a bit is O(1); erasing the last bit of a sentinel block walks inwards over the empty
+// blocks, so its cost is proportional to the gap skipped, which interleaved set/erase may repeat).
+// Updates through a BitBoardN reference (non virtual set_bit) are not tracked
+
+	void set_tracking				(bool track=true);							//turning it on fits the sentinels to the bit string
+	bool is_tracking				()	const	{return m_track;}
+
 //////////////
 // basic overwritten operations (could be extended)
 	
-	//erase: will not update sentinels	
+	//set: will not update sentinels (unless in tracking mode)
+	void  set_bit					(int nBit);
+	int	  set_bit					(int low, int high);						//closed range
+	void  set_bit					()						{BitBoardN::set_bit(); if(m_track) init_sentinels(false);}
+	void  set_bit					(const BitBoardN& bb_add);					//OR
+
+	//erase: will not update sentinels (unless in tracking mode)
 virtual	void  erase_bit				();											//in sentinel range
-virtual	void  erase_bit				(int nBit) {BitBoardN::erase_bit(nBit);}	//required because of the cast-to-int construction of sentinels (1)
+virtual	void  erase_bit				(int nBit);									//required because of the cast-to-int construction of sentinels (1)
 	void  erase_bit_and_update		(int nBit);									//erases and updates sentinels			
 	BBSentinel& erase_bit			(const BitBoardN&);							//(1): required for SEQ coloring
 	
@@ -69,10 +91,19 @@ virtual	bool is_empty				(int nBBL, int nBBH) const;					//is empty in range
 #ifdef POPCOUNT_64
 	int popcn64					() const;
 #endif
+	
+	//fused population count of set operations in the sentinel range (no intermediate bit string)
+	int popcount_and			(const BitBoardN& rhs) const;
+	int popcount_andnot			(const BitBoardN& rhs) const;
+	int popcount_or				(const BitBoardN& rhs) const;					//also counts rhs outside the sentinel range
+	int popcount_xor			(const BitBoardN& rhs) const;					//also counts rhs outside the sentinel range
+
+	int decode					(int* out, int max) const;						//in the sentinel range
 
 ////////////////
 // operators
 	BBSentinel& operator=		(const BBSentinel&);
+	BBSentinel& operator=		(BBSentinel&&) noexcept;						//takes over the bit string and sentinels
 	BBSentinel& operator&=		(const BitBoardN&);
 
 //////////////
@@ -91,146 +122,158 @@ virtual inline	int next_bit_del (BBSentinel& bbN_del);
 virtual inline	int next_bit();
 virtual inline	int next_bit(int& nBB);
 
+	//non destructive scans in the sentinel range with an external cursor (destructive scans use the sentinels as cursors)
+	int init_scan(scan_cursor&, scan_types) const;
+inline	int next_bit(scan_cursor&) const;
+inline	int previous_bit(scan_cursor&) const;
+	using BBIntrin::previous_bit;
+
 protected:	
 	 int m_BBH;										//explicit storage for sentinel high index
 	 int m_BBL;										//explicit storage for sentinel low index
+	 bool m_track;									//tracking mode: sentinels are kept exact
 };
 
-#endif
+/////////////////////////////////
+//
+// class BBSentinelView
+// (BBSentinel over bitblocks owned elsewhere, e.g. the rows of a BitMatrix)
+//
+// The sentinels belong to the view and are fitted on construction. The storage is never released (BBNullAlloc)
+// and the size is fixed, as in BBIntrinView: assignment copies all the bits of a bit string of the same
+// size and fits the sentinels
+//
+///////////////////////////////////
+
+class BBSentinelView: public BBSentinel{
+public:
+	BBSentinelView					(BITBOARD* aBB, int nBB){
+										m_aBB=aBB;
+										m_nBB=nBB;
+										m_cap=nBB;
+										m_alloc=&BBNullAlloc::instance();
+										init_sentinels(true);
+									}
+	BBSentinelView					(const BBSentinelView& bbv):BBSentinel(bbv){}
+	BBSentinelView					(BBSentinelView&& bbv) noexcept:BBSentinel(std::move(bbv)){}
+
+	BBSentinelView& operator =		(const BBSentinelView& bbv)		{operator=((const BitBoardN&)bbv); return *this;}
+virtual	BitBoardN& operator =		(const BitBoardN& bbN);										//RETURNS *this unchanged if the sizes differ
+	BBSentinelView& operator =		(BBSentinelView&& )=delete;
+
+	void init						(int popsize, bool reset=true)=delete;
+	void init						(int popsize, const vector<int>& )=delete;
+	int  reserve					(int popsize)=delete;
+	int  resize						(int popsize)=delete;
+};
+
+/////////////////////////////////
+//
+// class BBSentinelScan
+// (scanning of a BBSentinel with static dispatch, see BBScan)
+//
+// Scans are restricted to the sentinel range and destructive scans move the sentinels
+//
+///////////////////////////////////
+
+class BBSentinelScan: public BBScan<BBSentinelScan>{
+	friend class BBScan<BBSentinelScan>;
+public:
+explicit BBSentinelScan					(BBSentinel& bb):m_bb(bb), m_scan(bb.m_scan){}
+	BBSentinelScan						(BBSentinel& bb, BBIntrin::scan_t& sc):m_bb(bb), m_scan(sc){}		//external cursor
+
+	bool is_empty						()	const	{return (m_bb.m_BBL==EMPTY_ELEM || m_bb.m_BBH==EMPTY_ELEM);}
+
+private:
+	BITBOARD* bitblocks					()	const	{return m_bb.m_aBB;}
+	int low_block						()	const	{return m_bb.m_BBL;}
+	int high_block						()	const	{return m_bb.m_BBH;}
+	BBIntrin::scan_t& scan_state		()			{return m_scan;}
+	int& cursor_low						()			{return m_bb.m_BBL;}
+	int& cursor_high					()			{return m_bb.m_BBH;}
+	void prepare_scan					()			{m_bb.update_sentinels();}
+
+	BBSentinel& m_bb;
+	BBIntrin::scan_t& m_scan;
+};
+
+///////////////////////
+//
+// INLINE FUNCTIONS
+// (thin adapters of BBSentinelScan)
+// 
+////////////////////////
 
 #ifdef POPCOUNT_64
 inline int BBSentinel::popcn64() const{
-	BITBOARD pc=0;
-	for(int i=m_BBL; i<=m_BBH; i++){
-		pc+=__popcnt64(m_aBB[i]);
-	}
-return pc;
+	return BBSentinelScan(const_cast<BBSentinel&>(*this)).popcn64();			//read only
 }
 
 #endif
 
-//specializes the only bitscan function used
 inline
-int BBSentinel::previous_bit_del(){
-//////////////
-// BitScan reverse order and distructive
-//
-// COMMENTS
-// 1- update sentinels at the start of loop
-
-	unsigned long posInBB;
+void BBSentinel::set_bit(int nBit){
+	BitBoardN::set_bit(nBit);
+	if(m_track) update_sentinels_to_v(nBit);
+}
 
-	for(int i=m_BBH; i>=m_BBL; i--){
-		if(_BitScanReverse64(&posInBB,m_aBB[i])){
-			m_BBH=i;
-			m_aBB[i]&=~Tables::mask[posInBB];			//erase before the return
-			return (posInBB+WMUL(i));
-		}
+inline
+int BBSentinel::set_bit(int low, int high){
+	int res=BitBoardN::set_bit(low, high);
+	if(m_track && res!=-1){
+		update_sentinels_to_v(low);
+		update_sentinels_to_v(high);
 	}
-return EMPTY_ELEM;  
+return res;
 }
 
 inline
-int BBSentinel::next_bit_del (){
-//////////////
-// Bitscan distructive between sentinels
-//
-// COMMENTS
-// 1- update sentinels at the start of loop
+void BBSentinel::erase_bit(int nBit){
+	if(m_track)
+		erase_bit_and_update(nBit);
+	else
+		BitBoardN::erase_bit(nBit);
+}
 
-	unsigned long posInBB;
+inline
+int BBSentinel::previous_bit_del(){
+	return BBSentinelScan(*this).previous_bit_del();
+}
 
-	for(int i=m_BBL; i<=m_BBH; i++){
-		if(_BitScanForward64(&posInBB,m_aBB[i]) ){
-			m_BBL=i;
-			m_aBB[i]&=~Tables::mask[posInBB];					//erase before the return
-			return (posInBB+ WMUL(i));
-		}
-	}
-return EMPTY_ELEM;  
+inline
+int BBSentinel::next_bit_del (){
+	return BBSentinelScan(*this).next_bit_del();
 }
 
 inline
 int BBSentinel::next_bit_del (BBSentinel& bbN_del){
-//////////////
-// Bitscan distructive between sentinels
-//
-// COMMENTS
-// 1- update sentinels at the start of loop (experimental, does not use sentinesl of bbN_del)
-
-	unsigned long posInBB;
-
-	for(int i=m_BBL; i<=m_BBH; i++){
-		if(_BitScanForward64(&posInBB, m_aBB[i]) ){
-			m_BBL=i;
-			m_aBB[i]&=~Tables::mask[posInBB];					//erase before the return
-			bbN_del.m_aBB[i]&=~Tables::mask[posInBB];
-			return (posInBB+ WMUL(i));
-		}
-	}
-	
-return EMPTY_ELEM;  
-}
+////////////////
+// does not use the sentinels of bbN_del (experimental)
 
+	int nBB;
+	return BBSentinelScan(*this).next_bit_del(nBB, bbN_del);
+}
 
 inline
 int BBSentinel::next_bit(){
-////////////////////////////
-// last update:31/12/2013
-// BitScan non destructive
-//
-// COMMENTS
-// 1- update sentinels, set m_scan.bbi to m_BBL and set m_scan.pos to MASK_LIM at the start of loop
-
-	unsigned long posInBB;
-				
-	if(_BitScanForward64(&posInBB, m_aBB[m_scan.bbi] & Tables::mask_left[m_scan.pos])){
-		m_scan.pos =posInBB;
-		return (posInBB + WMUL(m_scan.bbi));
-	}else{													
-		for(int i=m_scan.bbi+1; i<=m_BBH; i++){
-			if(_BitScanForward64(&posInBB,m_aBB[i])){
-				m_scan.bbi=i;
-				m_scan.pos=posInBB;
-				return (posInBB+ WMUL(i));
-			}
-		}
-	}
-return EMPTY_ELEM;
+	return BBSentinelScan(*this).next_bit();
 }
 
 inline
 int BBSentinel::next_bit(int& nBB){
-////////////////////////////
-// last update:31/12/2013
-// BitScan non destructive
-//
-// COMMENTS
-// 1- update sentinels, set m_scan.bbi to m_BBL and set m_scan.pos to MASK_LIM at the start of loop
-
-	unsigned long posInBB;
-			
-	//look uo in the last table
-	if(_BitScanForward64(&posInBB, m_aBB[m_scan.bbi] & Tables::mask_left[m_scan.pos])){
-		m_scan.pos =posInBB;
-		nBB=m_scan.bbi;
-		return (posInBB + WMUL(m_scan.bbi));
-	}else{											//not found in the last table. look up in the rest
-		for(int i=(m_scan.bbi+1); i<=m_BBH; i++){
-			if(_BitScanForward64(&posInBB,m_aBB[i])){
-				m_scan.bbi=i;
-				m_scan.pos=posInBB;
-				nBB=i;
-				return (posInBB+ WMUL(i));
-			}
-		}
-	}
-return EMPTY_ELEM;
+	return BBSentinelScan(*this).next_bit(nBB);
 }
 
+inline
+int BBSentinel::next_bit(scan_cursor& sc) const{
+	if(sc.bbi==EMPTY_ELEM) return EMPTY_ELEM;										//end of the scan of empty sentinels
+	return BBSentinelScan(const_cast<BBSentinel&>(*this), sc).next_bit();			//read only
+}
 
+inline
+int BBSentinel::previous_bit(scan_cursor& sc) const{
+	if(sc.bbi==EMPTY_ELEM) return EMPTY_ELEM;
+	return BBSentinelScan(const_cast<BBSentinel&>(*this), sc).previous_bit();		//read only
+}
 
-
-
-
-
+#endif
@@ -0,0 +1,487 @@
+/*
+ * bbstatic.h file from the BITSCAN library, a C++ library for bit set
+ * optimization. BITSCAN has been used to implement BBMC, a very
+ * succesful bit-parallel algorithm for exact maximum clique.
+ * (see license file for references)
+ *
+ * Copyright (C)
+ * Author: Pablo San Segundo
+ * Intelligent Control Research Group (CSIC-UPM)
+ *
+ * Permission to use, modify and distribute this software is
+ * granted provided that this copyright notice appears in all
+ * copies, in source code or in binaries. For precise terms
+ * see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any
+ * kind, express or implied, and with no claim as to its
+ * suitability for any purpose.
+ *
+ */
+
+#ifndef __BB_STATIC_H__
+#define __BB_STATIC_H__
+
+#include "bbobject.h"
+#include "bitboard.h"
+#include "bbkernel.h"
+#include <array>
+#include <vector>
+
+using namespace std;
+
+/////////////////////////////////
+//
+// class StaticBitBoard
+// (bit string of NBITS bits with size known at compile time)
+//
+// Storage is inline (std::array) so small instances live on the stack or in registers.
+// Same scanning API as BBIntrin without virtual dispatch: loop bounds are compile-time
+// constants, which the compiler unrolls for small NBITS.
+// Bits in [NBITS, WMUL(NBB)[ are always 0.
+//
+///////////////////////////////////
+
+template<int NBITS>
+class StaticBitBoard{
+public:
+	static const int NBB=INDEX_1TO1(NBITS);												//number of bitblocks
+
+	typedef BBObject::scan_types scan_types;
+	typedef BBObject::scan_cursor scan_t;												//for bitscanning optimization
+
+//non standard independent operators (no allocation or copies)
+	template<int N> friend StaticBitBoard<N>& AND	(const StaticBitBoard<N>& lhs, const StaticBitBoard<N>& rhs, StaticBitBoard<N>& res);
+	template<int N> friend StaticBitBoard<N>& OR	(const StaticBitBoard<N>& lhs, const StaticBitBoard<N>& rhs, StaticBitBoard<N>& res);
+	template<int N> friend StaticBitBoard<N>& ERASE	(const StaticBitBoard<N>& lhs, const StaticBitBoard<N>& rhs, StaticBitBoard<N>& res);
+
+//constructors
+	StaticBitBoard						()			{erase_bit();}
+	StaticBitBoard						(const vector<int>& v);									//bits in [0, NBITS[
+
+/////////////////////
+//setters and getters
+
+	BITBOARD* get_bitstring				()			{return m_aBB.data();}
+	const BITBOARD* get_bitstring		()	const	{return m_aBB.data();}
+	static int number_of_bitblocks		()			{return NBB;}
+	static int capacity					()			{return NBITS;}
+	BITBOARD get_bitboard				(int block) const {return m_aBB[block];}
+	BITBOARD& get_bitboard				(int block)		  {return m_aBB[block];}
+
+	void set_bbindex					(int bbindex)	{m_scan.bbi=bbindex;}
+	void set_posbit						(int posbit)	{m_scan.pos=posbit;}
+
+//////////////////////////////
+// bitscanning
+
+	int lsbn64							()	const;
+	int msbn64							()	const;
+
+	int init_scan						(scan_types);
+	int init_scan_from					(int from, scan_types);
+
+	//bit scan forward (non destructive)
+	int next_bit						();
+	int next_bit						(int& nBB);
+
+	//bit scan forward (destructive)
+	int next_bit_del					();
+	int next_bit_del					(int& nBB);
+	int next_bit_del					(int& nBB,  StaticBitBoard& bb_del);
+
+	//bit scan backwards
+	int previous_bit					();
+	int previous_bit_del				();
+
+/////////////////
+// popcount
+	int popcn64							()						const;
+	int popcn64							(int nBit/*0 based*/)	const;
+	int popcount_and					(const StaticBitBoard& rhs)	const;			//|this & rhs|
+
+/////////////////////
+//set/delete bits
+	void set_bit						(int nBit)			{m_aBB[WDIV(nBit)]|=Tables::mask[WMOD(nBit)];}
+	int	 set_bit						(int low, int high);									//closed range
+	void set_bit						();														//bits in [0, NBITS[
+	void erase_bit						(int nBit)			{m_aBB[WDIV(nBit)]&=~Tables::mask[WMOD(nBit)];}
+	void erase_bit						()					{for(int i=0; i<NBB; i++) m_aBB[i]=ZERO;}
+	StaticBitBoard& erase_bit			(const StaticBitBoard& bb_del);
+
+////////////////////////
+//member operators
+	StaticBitBoard& operator &=			(const StaticBitBoard& );
+	StaticBitBoard& operator |=			(const StaticBitBoard& );
+	StaticBitBoard& operator ^=			(const StaticBitBoard& );
+	bool operator ==					(const StaticBitBoard& )	const;
+	bool operator !=					(const StaticBitBoard& rhs)	const {return !(*this==rhs);}
+
+/////////////////////////////
+//boolean functions
+	bool is_bit							(int nBit)					const {return (m_aBB[WDIV(nBit)] & Tables::mask[WMOD(nBit)]);}
+	bool is_empty						()							const;
+	bool is_disjoint					(const StaticBitBoard& rhs)	const;
+
+/////////////////////
+// I/O
+	void print							(std::ostream& o= std::cout, bool show_pc = true)	const;
+	void to_vector						(std::vector<int>& )								const;
+	int decode							(int* out, int max)	const	{return BBKernel::bb_decode(m_aBB.data(), NBB, 0, out, max);}
+
+private:
+	static BITBOARD last_block_mask		()			{return ~Tables::mask_left[WMOD(NBITS-1)];}
+
+////////////////////////
+//member data
+	std::array<BITBOARD, NBB> m_aBB;
+	scan_t m_scan;
+};
+
+///////////////////////
+//
+// INLINE FUNCTIONS
+//
+////////////////////////
+
+template<int NBITS>
+inline StaticBitBoard<NBITS>::StaticBitBoard(const vector<int>& v){
+	erase_bit();
+	for(int i=0; i<v.size(); i++){
+		if(v[i]>=0 && v[i]<NBITS)
+			set_bit(v[i]);
+	}
+}
+
+template<int NBITS>
+inline int StaticBitBoard<NBITS>::lsbn64() const{
+	unsigned long posBB;
+	for(int i=0; i<NBB; i++){
+		if(_BitScanForward64(&posBB, m_aBB[i]))
+			return(posBB+ WMUL(i));
+	}
+return EMPTY_ELEM;
+}
+
+template<int NBITS>
+inline int StaticBitBoard<NBITS>::msbn64() const{
+	unsigned long posBB;
+	for(int i=NBB-1; i>=0; i--){
+		if(_BitScanReverse64(&posBB, m_aBB[i]))
+			return (posBB+WMUL(i));
+	}
+return EMPTY_ELEM;
+}
+
+template<int NBITS>
+inline int StaticBitBoard<NBITS>::init_scan(scan_types sct){
+	switch(sct){
+	case BBObject::NON_DESTRUCTIVE:
+		set_bbindex(0);
+		set_posbit(MASK_LIM);
+		break;
+	case BBObject::NON_DESTRUCTIVE_REVERSE:
+		set_bbindex(NBB-1);
+		set_posbit(WORD_SIZE);		//mask_right[WORD_SIZE]=ONE
+		break;
+	case BBObject::DESTRUCTIVE:
+		set_bbindex(0);
+		break;
+	case BBObject::DESTRUCTIVE_REVERSE:
+		set_bbindex(NBB-1);
+		break;
+	default:
+		cerr<<"bad scan type"<<endl;
+		return -1;
+	}
+return 0;
+}
+
+template<int NBITS>
+inline int StaticBitBoard<NBITS>::init_scan_from(int from, scan_types sct){
+	switch(sct){
+	case BBObject::NON_DESTRUCTIVE:
+	case BBObject::NON_DESTRUCTIVE_REVERSE:
+		set_bbindex(WDIV(from));
+		set_posbit(WMOD(from));
+		break;
+	case BBObject::DESTRUCTIVE:
+	case BBObject::DESTRUCTIVE_REVERSE:
+		set_bbindex(WDIV(from));
+		break;
+	default:
+		cerr<<"bad scan type"<<endl;
+		return -1;
+	}
+return 0;
+}
+
+template<int NBITS>
+inline int StaticBitBoard<NBITS>::next_bit(){
+////////////////////////////
+// bitscan not destructive (requires init_scan(NON_DESTRUCTIVE))
+
+	unsigned long posInBB;
+
+	//search for next bit in the last block
+	if(_BitScanForward64(&posInBB, m_aBB[m_scan.bbi] & Tables::mask_left[m_scan.pos])){
+		m_scan.pos =posInBB;
+		return (posInBB + WMUL(m_scan.bbi));
+	}else{											//search in the remaining blocks
+		for(int i=m_scan.bbi+1; i<NBB; i++){
+			if(_BitScanForward64(&posInBB,m_aBB[i])){
+				m_scan.bbi=i;
+				m_scan.pos=posInBB;
+				return (posInBB+ WMUL(i));
+			}
+		}
+	}
+return EMPTY_ELEM;
+}
+
+template<int NBITS>
+inline int StaticBitBoard<NBITS>::next_bit(int& nBB){
+////////////////////////////
+// bitscan not destructive, also returns the bitblock of the bit
+
+	int nBit=next_bit();
+	if(nBit!=EMPTY_ELEM) nBB=m_scan.bbi;
+return nBit;
+}
+
+template<int NBITS>
+inline int StaticBitBoard<NBITS>::next_bit_del(){
+////////////////////////////
+// bitscan destructive: erases the bit scanned (requires init_scan(DESTRUCTIVE))
+
+	unsigned long posInBB;
+	for(int i=m_scan.bbi; i<NBB; i++){
+		if(_BitScanForward64(&posInBB,m_aBB[i])){
+			m_scan.bbi=i;
+			m_aBB[i]&=~Tables::mask[posInBB];			//deletes the current bit before returning
+			return (posInBB+WMUL(i));
+		}
+	}
+return EMPTY_ELEM;
+}
+
+template<int NBITS>
+inline int StaticBitBoard<NBITS>::next_bit_del(int& nBB){
+	int nBit=next_bit_del();
+	if(nBit!=EMPTY_ELEM) nBB=m_scan.bbi;
+return nBit;
+}
+
+template<int NBITS>
+inline int StaticBitBoard<NBITS>::next_bit_del(int& nBB, StaticBitBoard& bb_del){
+//////////////
+// also erases the returned bit from bb_del
+
+	int nBit=next_bit_del();
+	if(nBit!=EMPTY_ELEM){
+		nBB=m_scan.bbi;
+		bb_del.m_aBB[nBB]&=~Tables::mask[WMOD(nBit)];
+	}
+return nBit;
+}
+
+template<int NBITS>
+inline int StaticBitBoard<NBITS>::previous_bit(){
+////////////////////////////
+// bitscan not destructive in reverse order (requires init_scan(NON_DESTRUCTIVE_REVERSE))
+
+	unsigned long posInBB;
+
+	//search in the last block
+	if(_BitScanReverse64(&posInBB, m_aBB[m_scan.bbi] & Tables::mask_right[m_scan.pos])){
+		m_scan.pos =posInBB;
+		return (posInBB + WMUL(m_scan.bbi));
+	}else{											//search in the remaining blocks
+		for(int i=m_scan.bbi-1; i>=0; i--){
+			if(_BitScanReverse64(&posInBB,m_aBB[i])){
+				m_scan.bbi=i;
+				m_scan.pos=posInBB;
+				return (posInBB+ WMUL(i));
+			}
+		}
+	}
+return EMPTY_ELEM;
+}
+
+template<int NBITS>
+inline int StaticBitBoard<NBITS>::previous_bit_del(){
+	unsigned long posInBB;
+	for(int i=m_scan.bbi; i>=0; i--){
+		if(_BitScanReverse64(&posInBB,m_aBB[i])){
+			m_scan.bbi=i;
+			m_aBB[i]&=~Tables::mask[posInBB];			//deletes the current bit before returning
+			return (posInBB+WMUL(i));
+		}
+	}
+return EMPTY_ELEM;
+}
+
+template<int NBITS>
+inline int StaticBitBoard<NBITS>::popcn64() const{
+	int pc=0;
+	for(int i=0; i<NBB; i++)
+		pc+=BitBoard::popc64(m_aBB[i]);
+return pc;
+}
+
+template<int NBITS>
+inline int StaticBitBoard<NBITS>::popcn64(int nBit) const{
+/////////////////////////
+// population size from nBit (included) onwards
+
+	int nBB=WDIV(nBit);
+	int pc=BitBoard::popc64(m_aBB[nBB]&~Tables::mask_right[WMOD(nBit)]);
+	for(int i=nBB+1; i<NBB; i++)
+		pc+=BitBoard::popc64(m_aBB[i]);
+return pc;
+}
+
+template<int NBITS>
+inline int StaticBitBoard<NBITS>::popcount_and(const StaticBitBoard& rhs) const{
+	int pc=0;
+	for(int i=0; i<NBB; i++)
+		pc+=BitBoard::popc64(m_aBB[i] & rhs.m_aBB[i]);
+return pc;
+}
+
+template<int NBITS>
+inline int StaticBitBoard<NBITS>::set_bit(int low, int high){
+/////////////////////
+// sets all bits (0 based) to 1 in the closed range (including both ends)
+
+	int bbl= WDIV(low);
+	int bbh= WDIV(high);
+
+	if(bbh<bbl || bbl<0 || low>high || high>=NBITS){
+		cerr<<"Error in set bit in range"<<endl;
+		return -1;
+	}
+
+	if(bbl==bbh){
+		m_aBB[bbh]|=~Tables::mask_left[high-WMUL(bbh)] & ~Tables::mask_right[low-WMUL(bbl)];
+	}else{
+		for(int i=bbl+1; i<=bbh-1; i++)
+			m_aBB[i]=ONE;
+		m_aBB[bbh]|=~Tables::mask_left[high-WMUL(bbh)];
+		m_aBB[bbl]|=~Tables::mask_right[low-WMUL(bbl)];
+	}
+return 0;
+}
+
+template<int NBITS>
+inline void StaticBitBoard<NBITS>::set_bit(){
+	for(int i=0; i<NBB-1; i++)
+		m_aBB[i]=ONE;
+	m_aBB[NBB-1]=last_block_mask();
+}
+
+template<int NBITS>
+inline StaticBitBoard<NBITS>& StaticBitBoard<NBITS>::erase_bit(const StaticBitBoard& bb_del){
+	for(int i=0; i<NBB; i++)
+		m_aBB[i]&=~bb_del.m_aBB[i];
+return *this;
+}
+
+template<int NBITS>
+inline StaticBitBoard<NBITS>& StaticBitBoard<NBITS>::operator &=(const StaticBitBoard& rhs){
+	for(int i=0; i<NBB; i++)
+		m_aBB[i]&=rhs.m_aBB[i];
+return *this;
+}
+
+template<int NBITS>
+inline StaticBitBoard<NBITS>& StaticBitBoard<NBITS>::operator |=(const StaticBitBoard& rhs){
+	for(int i=0; i<NBB; i++)
+		m_aBB[i]|=rhs.m_aBB[i];
+return *this;
+}
+
+template<int NBITS>
+inline StaticBitBoard<NBITS>& StaticBitBoard<NBITS>::operator ^=(const StaticBitBoard& rhs){
+	for(int i=0; i<NBB; i++)
+		m_aBB[i]^=rhs.m_aBB[i];
+return *this;
+}
+
+template<int NBITS>
+inline bool StaticBitBoard<NBITS>::operator ==(const StaticBitBoard& rhs) const{
+	for(int i=0; i<NBB; i++)
+		if(m_aBB[i]!=rhs.m_aBB[i]) return false;
+return true;
+}
+
+template<int NBITS>
+inline bool StaticBitBoard<NBITS>::is_empty() const{
+	for(int i=0; i<NBB; i++)
+		if(m_aBB[i]) return false;
+return true;
+}
+
+template<int NBITS>
+inline bool StaticBitBoard<NBITS>::is_disjoint(const StaticBitBoard& rhs) const{
+	for(int i=0; i<NBB; i++)
+		if(m_aBB[i] & rhs.m_aBB[i]) return false;
+return true;
+}
+
+template<int NBITS>
+inline void StaticBitBoard<NBITS>::print(std::ostream& o, bool show_pc) const{
+/////////////////////////
+// shows bit string as [bit1 bit2 bit3 ... <(pc)>]  (if empty: [ ]) (<pc> optional)
+
+	o<<"[";
+	for(int i=0; i<NBB; i++){
+		BITBOARD bb=m_aBB[i];
+		while(bb){
+			int pos=BitBoard::lsb64_intrinsic(bb);
+			o<<(pos+WMUL(i))<<" ";
+			bb&=~Tables::mask[pos];
+		}
+	}
+
+	if(show_pc){
+		int pc=popcn64();
+		if(pc) o<<"("<<pc<<")";
+	}
+	o<<"]";
+}
+
+template<int NBITS>
+inline void StaticBitBoard<NBITS>::to_vector(std::vector<int>& lv) const{
+	lv.resize(popcn64());
+	if(!lv.empty()) decode(&lv[0], lv.size());
+}
+
+//////////////////////////
+//
+// FRIEND FUNCTIONS
+//
+//////////////////////////
+
+template<int N>
+inline StaticBitBoard<N>& AND(const StaticBitBoard<N>& lhs, const StaticBitBoard<N>& rhs, StaticBitBoard<N>& res){
+	for(int i=0; i<StaticBitBoard<N>::NBB; i++)
+		res.m_aBB[i]=lhs.m_aBB[i] & rhs.m_aBB[i];
+return res;
+}
+
+template<int N>
+inline StaticBitBoard<N>& OR(const StaticBitBoard<N>& lhs, const StaticBitBoard<N>& rhs, StaticBitBoard<N>& res){
+	for(int i=0; i<StaticBitBoard<N>::NBB; i++)
+		res.m_aBB[i]=lhs.m_aBB[i] | rhs.m_aBB[i];
+return res;
+}
+
+template<int N>
+inline StaticBitBoard<N>& ERASE(const StaticBitBoard<N>& lhs, const StaticBitBoard<N>& rhs, StaticBitBoard<N>& res){
+	for(int i=0; i<StaticBitBoard<N>::NBB; i++)
+		res.m_aBB[i]=lhs.m_aBB[i] & ~rhs.m_aBB[i];
+return res;
+}
+
+#endif
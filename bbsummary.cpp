@@ -0,0 +1,147 @@
+// bbsummary.cpp: implementation of the BBSummary class, dense bit strings with a hierarchical index of non-empty bitblocks
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "bbsummary.h"
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////
+// Summary
+//////////////////////////////////////////////////////////////////////
+
+void BBSummary::build_summary(){
+////////////////
+// one bit per bitblock at level 0, one bit per word of the level below for the rest
+// (the top level is a single word)
+
+	m_sum.clear();
+	if(m_nBB<=0) return;
+
+	int n=m_nBB;
+	do{
+		n=INDEX_1TO1(n);
+		m_sum.push_back(vsum(n, ZERO));
+	}while(n>1);
+
+	for(int i=0; i<m_nBB; i++){
+		if(m_aBB[i]) m_sum[0][WDIV(i)]|=Tables::mask[WMOD(i)];
+	}
+	for(int l=1; l<m_sum.size(); l++){
+		for(int i=0; i<m_sum[l-1].size(); i++){
+			if(m_sum[l-1][i]) m_sum[l][WDIV(i)]|=Tables::mask[WMOD(i)];
+		}
+	}
+}
+
+void BBSummary::update_summary(int first_block, int last_block){
+	for(int i=first_block; i<=last_block; i++){
+		if(m_aBB[i])
+			set_summary(i);
+		else
+			clear_summary(i);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// Set/Delete Bits
+//////////////////////////////////////////////////////////////////////
+
+int BBSummary::set_bit(int low, int high){
+	int res=BitBoardN::set_bit(low, high);
+	if(res!=-1){
+		for(int i=WDIV(low); i<=WDIV(high); i++)
+			set_summary(i);
+	}
+return res;
+}
+
+void BBSummary::set_bit(){
+	BitBoardN::set_bit();
+	build_summary();
+}
+
+void BBSummary::set_bit(const BitBoardN& bb_add){
+	BitBoardN::set_bit(bb_add);
+	update_summary(0, m_nBB-1);
+}
+
+int BBSummary::erase_bit(int low, int high){
+	int res=BitBoardN::erase_bit(low, high);
+	if(res!=-1)
+		update_summary(WDIV(low), WDIV(high));
+return res;
+}
+
+void BBSummary::erase_bit(){
+	BitBoardN::erase_bit();
+	for(int l=0; l<m_sum.size(); l++)
+		fill(m_sum[l].begin(), m_sum[l].end(), ZERO);
+}
+
+BBSummary& BBSummary::erase_bit(const BitBoardN& bb_del){
+/////////////////
+// only the non-empty blocks (found through the summary) are visited
+
+	for(int i=next_block(0); i!=EMPTY_ELEM; i=next_block(i+1)){
+		if(!(m_aBB[i]&=~bb_del.get_bitboard(i)))
+			clear_summary(i);
+	}
+return *this;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Operators
+//////////////////////////////////////////////////////////////////////
+
+BBSummary& BBSummary::operator &=(const BitBoardN& rhs){
+/////////////////
+// only the non-empty blocks (found through the summary) are visited
+
+	for(int i=next_block(0); i!=EMPTY_ELEM; i=next_block(i+1)){
+		if(!(m_aBB[i]&=rhs.get_bitboard(i)))
+			clear_summary(i);
+	}
+return *this;
+}
+
+BBSummary& BBSummary::operator |=(const BitBoardN& rhs){
+	BitBoardN::operator|=(rhs);
+	update_summary(0, m_nBB-1);
+return *this;
+}
+
+BBSummary& BBSummary::operator ^=(const BitBoardN& rhs){
+	BitBoardN::operator^=(rhs);
+	update_summary(0, m_nBB-1);
+return *this;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Bit scanning
+//////////////////////////////////////////////////////////////////////
+
+int BBSummary::init_scan(scan_cursor& sc, scan_types sct) const{
+	switch(sct){
+	case NON_DESTRUCTIVE:
+		sc.bbi=0;
+		sc.pos=MASK_LIM;
+		break;
+	case NON_DESTRUCTIVE_REVERSE:
+		sc.bbi=m_nBB-1;
+		sc.pos=WORD_SIZE;							//mask_right[WORD_SIZE]=ONE
+		break;
+	case DESTRUCTIVE:
+		sc.bbi=0;
+		break;
+	case DESTRUCTIVE_REVERSE:
+		sc.bbi=m_nBB-1;
+		break;
+	default:
+		cerr<<"bad scan type"<<endl;
+		return -1;
+	}
+return 0;
+}
@@ -0,0 +1,295 @@
+/*
+ * bbsummary.h file from the BITSCAN library, a C++ library for bit set
+ * optimization. BITSCAN has been used to implement BBMC, a very
+ * succesful bit-parallel algorithm for exact maximum clique.
+ * (see license file for references)
+ *
+ * Copyright (C)
+ * Author: Pablo San Segundo
+ * Intelligent Control Research Group (CSIC-UPM)
+ *
+ * Permission to use, modify and distribute this software is
+ * granted provided that this copyright notice appears in all
+ * copies, in source code or in binaries. For precise terms
+ * see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any
+ * kind, express or implied, and with no claim as to its
+ * suitability for any purpose.
+ *
+ */
+
+#ifndef __BB_SUMMARY_H__
+#define __BB_SUMMARY_H__
+
+#include "bbintrinsic.h"
+#include <vector>
+
+using namespace std;
+
+/////////////////////////////////
+//
+// class BBSummary
+// (Dense bit strings with a hierarchical index of non-empty bitblocks)
+//
+// Level 0 of the summary has one bit per bitblock (1 if the block is not empty), level 1
+// one bit per word of level 0 and so on up to a single word (a 64-ary van Emde Boas like tree).
+// The next (previous) non-empty block is found with one bit scan per level, so scans,
+// lsbn64, msbn64 and is_empty do not depend on the gaps between 1-bits: for 10^6 bits
+// there are 3 levels.
+//
+// The summary is kept in sync by the set/erase members and the destructive scans of this class.
+// Updates through a base class reference (non virtual BitBoardN members), through the AND/OR/ERASE
+// friends of BitBoardN or through a BBIntrinScan view are not tracked: call build_summary() after them
+//
+///////////////////////////////////
+
+class BBSummary: public BBIntrin{
+public:
+	typedef vector<BITBOARD> vsum;
+
+	BBSummary						(){}
+explicit BBSummary					(int popsize /*1 based*/, bool reset=true):BBIntrin(popsize, reset){build_summary();}
+	BBSummary						(const BBSummary& bbN):BBIntrin(bbN), m_sum(bbN.m_sum){}
+	BBSummary						(BBSummary&& bbN) noexcept:BBIntrin(std::move(bbN)), m_sum(std::move(bbN.m_sum)){}
+explicit BBSummary					(const BitBoardN& bbN):BBIntrin(bbN.number_of_bitblocks()*WORD_SIZE){*this=bbN;}
+virtual ~BBSummary					(){}
+
+	void init						(int popsize, bool reset=true)	{BitBoardN::init(popsize, reset); build_summary();}
+	BBSummary& operator =			(const BBSummary& bbN)			{BBIntrin::operator=(bbN); m_sum=bbN.m_sum; return *this;}
+	BBSummary& operator =			(BBSummary&& bbN) noexcept		{BBIntrin::operator=(std::move(bbN)); m_sum=std::move(bbN.m_sum); bbN.m_sum.clear(); return *this;}
+virtual	BitBoardN& operator =		(const BitBoardN& bbN)			{BitBoardN::operator=(bbN); build_summary(); return *this;}
+
+/////////////////////
+// summary
+	void build_summary				();														//rebuilds all levels from the bitblocks
+	int number_of_levels			()			const	{return m_sum.size();}
+	const vsum& get_level			(int l)		const	{return m_sum[l];}
+inline	int next_block				(int nBB)	const;										//first non-empty block >= nBB (EMPTY_ELEM if none)
+inline	int previous_block			(int nBB)	const;										//last non-empty block <= nBB (EMPTY_ELEM if none)
+
+/////////////////////
+// Set/Delete Bits (the summary is updated)
+inline	void  set_bit				(int nBit);
+		int	  set_bit				(int low, int high);										//closed range
+		void  set_bit				();
+		void  set_bit				(const BitBoardN& bb_add);									//OR
+inline	void  erase_bit				(int nBit);
+		int   erase_bit				(int low, int high);
+		void  erase_bit				();
+		BBSummary& erase_bit		(const BitBoardN& bb_del);
+
+	BBSummary& operator &=			(const BitBoardN& );
+	BBSummary& operator |=			(const BitBoardN& );
+	BBSummary& operator ^=			(const BitBoardN& );
+
+/////////////////////////////
+// Boolean functions
+inline virtual bool is_empty		()						const	{return (m_sum.empty() || !m_sum.back()[0]);}
+	using BBIntrin::is_empty;
+
+//////////////////////////////
+// Bitscanning (empty bitblocks are skipped through the summary)
+inline virtual int lsbn64			()						const	{int nBB=next_block(0); return (nBB==EMPTY_ELEM)? EMPTY_ELEM : bblsb(nBB);}
+inline virtual int msbn64			()						const	{int nBB=previous_block(m_nBB-1); return (nBB==EMPTY_ELEM)? EMPTY_ELEM : bbmsb(nBB);}
+
+virtual	int init_scan				(scan_types sct)				{return init_scan(m_scan, sct);}
+	int init_scan					(scan_cursor&, scan_types)		const;
+
+virtual inline int next_bit			()								{return next_bit(m_scan);}
+virtual inline int next_bit			(int& nBB)						{int v=next_bit(m_scan); nBB=m_scan.bbi; return v;}
+virtual inline int previous_bit		()								{return previous_bit(m_scan);}
+virtual inline int next_bit_del		()								{return next_bit_del(m_scan);}
+virtual inline int next_bit_del		(int& nBB)						{int v=next_bit_del(m_scan); nBB=m_scan.bbi; return v;}
+virtual inline int next_bit_del		(int& nBB, BBIntrin& bbN_del);
+virtual inline int previous_bit_del	()								{return previous_bit_del(m_scan);}
+	inline int previous_bit_del		(int& nBB)						{int v=previous_bit_del(m_scan); nBB=m_scan.bbi; return v;}
+	inline int previous_bit_del		(int& nBB, BBIntrin& del);
+	using BBIntrin::next_bit;
+
+	//scans with an external cursor
+inline int next_bit					(scan_cursor&)					const;
+inline int previous_bit				(scan_cursor&)					const;
+inline int next_bit_del				(scan_cursor&);
+inline int previous_bit_del			(scan_cursor&);
+
+protected:
+inline void set_summary				(int nBB);												//nBB is not empty
+inline void clear_summary			(int nBB);												//nBB is empty
+	void update_summary				(int first_block, int last_block);						//from the bitblocks in the closed range
+	int bblsb						(int nBB)				const	{unsigned long pos; _BitScanForward64(&pos, m_aBB[nBB]); return WMUL(nBB)+pos;}
+	int bbmsb						(int nBB)				const	{unsigned long pos; _BitScanReverse64(&pos, m_aBB[nBB]); return WMUL(nBB)+pos;}
+
+////////////////////////
+// Member data
+	vector<vsum> m_sum;											//m_sum[l]: one bit per word of level l-1 (per bitblock for l=0)
+};
+
+///////////////////////
+//
+// INLINE FUNCTIONS
+//
+////////////////////////
+
+inline int BBSummary::next_block(int nBB) const{
+//////////////////
+// climbs until a level has a 1-bit at or after the position, then descends through the least significant bits
+
+	const int nLev=m_sum.size();
+	int l=0, pos=nBB;
+	unsigned long posbb;
+	for(; l<nLev; l++){
+		int w=WDIV(pos);
+		if(w>=m_sum[l].size()) return EMPTY_ELEM;
+		if(_BitScanForward64(&posbb, m_sum[l][w] & ~Tables::mask_right[WMOD(pos)])){
+			pos=WMUL(w)+posbb;
+			break;
+		}
+		pos=w+1;
+	}
+	if(l==nLev) return EMPTY_ELEM;
+
+	while(l>0){
+		l--;
+		_BitScanForward64(&posbb, m_sum[l][pos]);
+		pos=WMUL(pos)+posbb;
+	}
+return pos;
+}
+
+inline int BBSummary::previous_block(int nBB) const{
+	const int nLev=m_sum.size();
+	int l=0, pos=nBB;
+	unsigned long posbb;
+	for(; l<nLev; l++){
+		if(pos<0) return EMPTY_ELEM;
+		int w=WDIV(pos);
+		if(_BitScanReverse64(&posbb, m_sum[l][w] & ~Tables::mask_left[WMOD(pos)])){
+			pos=WMUL(w)+posbb;
+			break;
+		}
+		pos=w-1;
+	}
+	if(l==nLev) return EMPTY_ELEM;
+
+	while(l>0){
+		l--;
+		_BitScanReverse64(&posbb, m_sum[l][pos]);
+		pos=WMUL(pos)+posbb;
+	}
+return pos;
+}
+
+inline void BBSummary::set_summary(int nBB){
+//////////////////
+// stops at the first word which was already non-empty (upper levels are already set)
+
+	for(int l=0; l<m_sum.size(); l++){
+		BITBOARD& w=m_sum[l][WDIV(nBB)];
+		bool was_set=(w!=0);
+		w|=Tables::mask[WMOD(nBB)];
+		if(was_set) return;
+		nBB=WDIV(nBB);
+	}
+}
+
+inline void BBSummary::clear_summary(int nBB){
+	for(int l=0; l<m_sum.size(); l++){
+		BITBOARD& w=m_sum[l][WDIV(nBB)];
+		w&=~Tables::mask[WMOD(nBB)];
+		if(w) return;
+		nBB=WDIV(nBB);
+	}
+}
+
+inline void BBSummary::set_bit(int nBit){
+	int nBB=WDIV(nBit);
+	if(!m_aBB[nBB]) set_summary(nBB);
+	m_aBB[nBB]|=Tables::mask[WMOD(nBit)];
+}
+
+inline void BBSummary::erase_bit(int nBit){
+	int nBB=WDIV(nBit);
+	if(m_aBB[nBB] && !(m_aBB[nBB]&=~Tables::mask[WMOD(nBit)]))
+		clear_summary(nBB);
+}
+
+inline int BBSummary::next_bit(scan_cursor& sc) const{
+////////////////////////////
+// non destructive: requires sc.bbi and sc.pos set by init_scan
+
+	unsigned long posbb;
+	if(_BitScanForward64(&posbb, m_aBB[sc.bbi] & Tables::mask_left[sc.pos])){
+		sc.pos=posbb;
+		return (posbb + WMUL(sc.bbi));
+	}
+
+	int nBB=next_block(sc.bbi+1);
+	if(nBB==EMPTY_ELEM) return EMPTY_ELEM;
+	_BitScanForward64(&posbb, m_aBB[nBB]);
+	sc.bbi=nBB;
+	sc.pos=posbb;
+return (posbb + WMUL(nBB));
+}
+
+inline int BBSummary::previous_bit(scan_cursor& sc) const{
+	unsigned long posbb;
+	if(_BitScanReverse64(&posbb, m_aBB[sc.bbi] & Tables::mask_right[sc.pos])){
+		sc.pos=posbb;
+		return (posbb + WMUL(sc.bbi));
+	}
+
+	int nBB=previous_block(sc.bbi-1);
+	if(nBB==EMPTY_ELEM) return EMPTY_ELEM;
+	_BitScanReverse64(&posbb, m_aBB[nBB]);
+	sc.bbi=nBB;
+	sc.pos=posbb;
+return (posbb + WMUL(nBB));
+}
+
+inline int BBSummary::next_bit_del(scan_cursor& sc){
+////////////////////////////
+// destructive: sc.bbi is a lower bound of the non-empty blocks
+
+	int nBB=next_block(sc.bbi);
+	if(nBB==EMPTY_ELEM) return EMPTY_ELEM;
+
+	unsigned long posbb;
+	_BitScanForward64(&posbb, m_aBB[nBB]);
+	if(!(m_aBB[nBB]&=~Tables::mask[posbb]))
+		clear_summary(nBB);
+	sc.bbi=nBB;
+return (posbb + WMUL(nBB));
+}
+
+inline int BBSummary::previous_bit_del(scan_cursor& sc){
+	int nBB=previous_block(sc.bbi);
+	if(nBB==EMPTY_ELEM) return EMPTY_ELEM;
+
+	unsigned long posbb;
+	_BitScanReverse64(&posbb, m_aBB[nBB]);
+	if(!(m_aBB[nBB]&=~Tables::mask[posbb]))
+		clear_summary(nBB);
+	sc.bbi=nBB;
+return (posbb + WMUL(nBB));
+}
+
+inline int BBSummary::next_bit_del(int& nBB, BBIntrin& bbN_del){
+	int v=next_bit_del(m_scan);
+	if(v!=EMPTY_ELEM){
+		nBB=m_scan.bbi;
+		bbN_del.get_bitboard(nBB)&=~Tables::mask[WMOD(v)];
+	}
+return v;
+}
+
+inline int BBSummary::previous_bit_del(int& nBB, BBIntrin& del){
+	int v=previous_bit_del(m_scan);
+	if(v!=EMPTY_ELEM){
+		nBB=m_scan.bbi;
+		del.get_bitboard(nBB)&=~Tables::mask[WMOD(v)];
+	}
+return v;
+}
+
+#endif
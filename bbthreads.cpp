@@ -0,0 +1,147 @@
+// bbthreads.cpp: implementation of the BBThreadPool class, worker threads for data parallel loops
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "bbthreads.h"
+#include <algorithm>
+
+using namespace std;
+
+BBThreadPool::BBThreadPool(int nthreads):m_gen(0), m_active(0), m_stop(false), m_task(NULL), m_n(0), m_chunk(0), m_nchunks(0), m_next(0), m_job(NULL){
+	if(nthreads<=0) nthreads=thread::hardware_concurrency();
+	if(nthreads<=0) nthreads=1;
+	m_tasks=new tasks_t[nthreads];
+	for(int i=1; i<nthreads; i++)										//the caller is the last thread
+		m_workers.push_back(thread(&BBThreadPool::worker, this, i-1));
+}
+
+BBThreadPool::~BBThreadPool(){
+	{
+		lock_guard<mutex> lock(m_mtx);
+		m_stop=true;
+	}
+	m_start.notify_all();
+	for(int i=0; i<m_workers.size(); i++)
+		m_workers[i].join();
+	delete [] m_tasks;
+}
+
+BBThreadPool& BBThreadPool::instance(){
+	static BBThreadPool pool(PARALLEL_THREADS);
+	return pool;
+}
+
+void BBThreadPool::run(int n, int grain, const task_t& f){
+////////////////
+// a few chunks per thread (for load balance), none smaller than grain
+
+	if(n<=0) return;
+	lock_guard<mutex> lock_run(m_run);
+
+	const int nthreads=number_of_threads();
+	int chunk=max(grain, 1);
+	chunk=max(chunk, (n+4*nthreads-1)/(4*nthreads));
+	const int nchunks=(n+chunk-1)/chunk;
+	if(nchunks==1 || m_workers.empty()){
+		f(0, n);
+		return;
+	}
+
+	{
+		lock_guard<mutex> lock(m_mtx);
+		m_task=&f;
+		m_n=n;
+		m_chunk=chunk;
+		m_nchunks=nchunks;
+		m_next=0;
+		m_active=m_workers.size();
+		m_gen++;
+	}
+	m_start.notify_all();
+
+	process();
+
+	unique_lock<mutex> lock(m_mtx);
+	while(m_active) m_done.wait(lock);
+	m_task=NULL;
+}
+
+void BBThreadPool::run_stealing(int ntasks, const job_t& f){
+	if(ntasks<=0) return;
+	lock_guard<mutex> lock_run(m_run);
+
+	const int nthreads=number_of_threads();
+	if(ntasks==1 || m_workers.empty()){
+		for(int k=0; k<ntasks; k++) f(k);
+		return;
+	}
+
+	//initial distribution: a contiguous block of tasks per thread
+	for(int t=0; t<nthreads; t++){
+		m_tasks[t].lo=(long long)ntasks*t/nthreads;
+		m_tasks[t].hi=(long long)ntasks*(t+1)/nthreads;
+	}
+
+	{
+		lock_guard<mutex> lock(m_mtx);
+		m_job=&f;
+		m_active=m_workers.size();
+		m_gen++;
+	}
+	m_start.notify_all();
+
+	steal(nthreads-1);
+
+	unique_lock<mutex> lock(m_mtx);
+	while(m_active) m_done.wait(lock);
+	m_job=NULL;
+}
+
+void BBThreadPool::worker(int id){
+	unsigned gen=0;
+	while(true){
+		{
+			unique_lock<mutex> lock(m_mtx);
+			while(!m_stop && gen==m_gen) m_start.wait(lock);
+			if(m_stop) return;
+			gen=m_gen;
+		}
+
+		if(m_job) steal(id);
+		else process();
+
+		lock_guard<mutex> lock(m_mtx);
+		if(--m_active==0) m_done.notify_one();
+	}
+}
+
+void BBThreadPool::process(){
+	for(int c=m_next++; c<m_nchunks; c=m_next++){
+		int begin=c*m_chunk;
+		(*m_task)(begin, min(begin+m_chunk, m_n));
+	}
+}
+
+void BBThreadPool::steal(int id){
+////////////////
+// no tasks are created during the loop, so a round of failed steals means there is nothing left
+
+	const int nthreads=number_of_threads();
+	while(true){
+		int k=pop_front(id);
+		for(int v=1; k==EMPTY_ELEM && v<nthreads; v++)
+			k=pop_back((id+v)%nthreads);
+		if(k==EMPTY_ELEM) return;
+		(*m_job)(k);
+	}
+}
+
+int BBThreadPool::pop_front(int id){
+	lock_guard<mutex> lock(m_tasks[id].mtx);
+	return (m_tasks[id].lo<m_tasks[id].hi)? m_tasks[id].lo++ : EMPTY_ELEM;
+}
+
+int BBThreadPool::pop_back(int id){
+	lock_guard<mutex> lock(m_tasks[id].mtx);
+	return (m_tasks[id].lo<m_tasks[id].hi)? --m_tasks[id].hi : EMPTY_ELEM;
+}
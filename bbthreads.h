@@ -0,0 +1,101 @@
+/*
+ * bbthreads.h file from the BITSCAN library, a C++ library for bit set
+ * optimization. BITSCAN has been used to implement BBMC, a very
+ * succesful bit-parallel algorithm for exact maximum clique.
+ * (see license file for references)
+ *
+ * Copyright (C)
+ * Author: Pablo San Segundo
+ * Intelligent Control Research Group (CSIC-UPM)
+ *
+ * Permission to use, modify and distribute this software is
+ * granted provided that this copyright notice appears in all
+ * copies, in source code or in binaries. For precise terms
+ * see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any
+ * kind, express or implied, and with no claim as to its
+ * suitability for any purpose.
+ *
+ */
+
+#ifndef __BB_THREADS_H__
+#define __BB_THREADS_H__
+
+#include "config.h"
+#include "bbtypes.h"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+using namespace std;
+
+/////////////////////////////////
+//
+// class BBThreadPool
+// (fixed set of worker threads for data parallel loops)
+//
+// run(n, grain, f) splits [0, n[ into chunks of at least grain elements and calls f(begin, end)
+// for each chunk. Chunks are claimed dynamically by the workers and by the calling thread,
+// and run() returns when all of them are done. Calls to run() from different threads are
+// serialized; run() must not be called from inside a task
+//
+// run_stealing(ntasks, f) calls f(k) for each task k in [0, ntasks[ with work stealing: each thread
+// owns a contiguous block of tasks which it processes in increasing order and, when it runs out,
+// steals the highest task left from the other threads. Suited to tasks of uneven cost
+//
+///////////////////////////////////
+
+class BBThreadPool{
+public:
+	typedef function<void (int begin, int end)> task_t;
+	typedef function<void (int task)> job_t;
+
+explicit BBThreadPool				(int nthreads=0);									//total threads including the caller (0: hardware concurrency)
+	~BBThreadPool					();
+
+	void run						(int n, int grain, const task_t& f);
+	void run_stealing				(int ntasks, const job_t& f);
+	int number_of_threads			()				const	{return m_workers.size()+1;}
+
+	static BBThreadPool& instance	();													//default pool (PARALLEL_THREADS in config.h)
+
+private:
+	BBThreadPool(const BBThreadPool&);
+	BBThreadPool& operator=(const BBThreadPool&);
+
+	void worker						(int id);
+	void process					();													//claims chunks until none are left
+	void steal						(int id);											//runs own tasks, then steals, until none are left
+	int pop_front					(int id);											//EMPTY_ELEM if no task is left
+	int pop_back					(int id);
+
+	struct tasks_t{																		//tasks [lo, hi[ owned by a thread
+		mutex mtx;
+		int lo;
+		int hi;
+	};
+
+	vector<thread> m_workers;
+	mutex m_run;																		//one run() at a time
+	mutex m_mtx;
+	condition_variable m_start;
+	condition_variable m_done;
+	unsigned m_gen;																		//incremented by each run()
+	int m_active;																		//workers which have not finished the current run()
+	bool m_stop;
+
+	//current loop
+	const task_t* m_task;
+	int m_n;
+	int m_chunk;
+	int m_nchunks;
+	atomic<int> m_next;																	//next chunk to claim
+	const job_t* m_job;																	//current run_stealing() loop
+	tasks_t* m_tasks;																	//one per thread
+};
+
+#endif
@@ -0,0 +1,76 @@
+// bench_bbmc.cpp: macro-benchmark of the BBMC maximum clique engine on DIMACS instances (Google Benchmark)
+//
+// Times init (ordering and renumbering of the graph) plus search for each instance and type of
+// scan of the color classes (DESTRUCTIVE, NON_DESTRUCTIVE). The instances are the DIMACS files
+// passed as arguments or, if there are none, a few uniform random graphs (fixed seed).
+//
+// Counters:
+//	omega		: size of a maximum clique
+//	steps		: nodes of the search tree
+//
+// Build and run (see README):
+//	g++ -std=c++11 -O2 -mpopcnt bench/bench_bbmc.cpp *.cpp -lbenchmark -lpthread -o bench_bbmc
+//	./bench_bbmc brock200_1.clq keller4.clq
+
+#include <random>
+#include <memory>
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include "../bitscan.h"
+#include <benchmark/benchmark.h>
+
+using namespace std;
+
+static void random_graph(BitMatrix& g, int n, double p){
+	mt19937 gen(1234);
+	uniform_real_distribution<double> dist(0.0, 1.0);
+	g.init(n, n);
+	for(int i=0; i<n; i++)
+		for(int j=i+1; j<n; j++)
+			if(dist(gen)<p) g.set_symmetric(i, j);
+}
+
+static void BM_bbmc(benchmark::State& state, const BitMatrix* g, BBObject::scan_types sct){
+	BBMC mc;
+	for(auto _ : state){
+		mc.init(*g);
+		mc.set_scan(sct);
+		benchmark::DoNotOptimize(mc.search());
+	}
+	state.counters["omega"]=mc.clique().size();
+	state.counters["steps"]=mc.number_of_steps();
+}
+
+int main(int argc, char** argv){
+	benchmark::Initialize(&argc, argv);
+
+	vector< unique_ptr<BitMatrix> > graphs;
+	vector<string> names;
+	if(argc>1){
+		for(int i=1; i<argc; i++){
+			graphs.push_back(unique_ptr<BitMatrix>(new BitMatrix()));
+			if(BBMC::read_dimacs(argv[i], *graphs.back())==-1) return 1;
+			string name(argv[i]);
+			names.push_back(name.substr(name.find_last_of("/\\")+1));
+		}
+	}else{
+		const int n[]={150, 300, 1000};
+		const double p[]={0.9, 0.6, 0.3};
+		for(int i=0; i<3; i++){
+			graphs.push_back(unique_ptr<BitMatrix>(new BitMatrix()));
+			random_graph(*graphs.back(), n[i], p[i]);
+			ostringstream name;
+			name<<"random_"<<n[i]<<"_"<<p[i];
+			names.push_back(name.str());
+		}
+	}
+
+	for(int i=0; i<graphs.size(); i++){
+		benchmark::RegisterBenchmark((names[i]+"/DESTRUCTIVE").c_str(), BM_bbmc, graphs[i].get(), BBObject::DESTRUCTIVE)->Unit(benchmark::kMillisecond);
+		benchmark::RegisterBenchmark((names[i]+"/NON_DESTRUCTIVE").c_str(), BM_bbmc, graphs[i].get(), BBObject::NON_DESTRUCTIVE)->Unit(benchmark::kMillisecond);
+	}
+	benchmark::RunSpecifiedBenchmarks();
+return 0;
+}
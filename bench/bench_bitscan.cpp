@@ -0,0 +1,272 @@
+// bench_bitscan.cpp: micro-benchmarks of bit scanning and population count (Google Benchmark)
+//
+// Compares the alternative implementations of the basic 64-bit primitives (lsb64_*, popc64_*)
+// and the scanning loops of the bit string types (BBIntrin, BBSentinel, BBIntrinS) for the
+// four scan types, as a function of population size and density (percentage of 1-bits).
+// Also times the 64x64 transpose kernels and the transposition of a BitMatrix.
+//
+// Counters:
+//	time/bit	: time per 1-bit enumerated (SI prefix, i.e. n=ns)
+//	bytes_per_second: bitblock storage traversed per second
+//
+// Build (see README):
+//	g++ -std=c++11 -O2 -mpopcnt bench/bench_bitscan.cpp *.cpp -lbenchmark -lpthread -o bench_bitscan
+
+#include <random>
+#include <atomic>
+#include <vector>
+
+#include "../bitscan.h"
+#include <benchmark/benchmark.h>
+
+using namespace std;
+
+static const int NUM_WORDS=4096;				//64-bit words per iteration of the primitive benchmarks
+
+//////////////////////
+//
+// Data generation (fixed seed: runs are reproducible)
+//
+//////////////////////
+
+static vector<BITBOARD> random_words(bool single_bit){
+////////////////
+// non-empty words, either uniformly random or with a single 1-bit in a random position
+// (the latter makes the cost of the lookup based scans position dependent)
+
+	mt19937_64 gen(1234);
+	vector<BITBOARD> v(NUM_WORDS);
+	for(int i=0; i<NUM_WORDS; i++){
+		if(single_bit)
+			v[i]=ONE<<(gen()%WORD_SIZE);
+		else
+			while((v[i]=gen())==0);
+	}
+return v;
+}
+
+template<class BitSet_t>
+static void random_bitset(BitSet_t& bb, int popsize, int density){
+////////////////
+// sets each bit in [0, popsize[ with probability density/100
+
+	mt19937 gen(1234);
+	uniform_int_distribution<int> dist(0,99);
+	for(int i=0; i<popsize; i++)
+		if(dist(gen)<density) bb.set_bit(i);
+}
+
+//////////////////////
+//
+// 64-bit primitives
+//
+//////////////////////
+
+template<int (*LSB)(const BITBOARD)>
+static void BM_lsb64(benchmark::State& state){
+	vector<BITBOARD> v=random_words(state.range(0)!=0);
+	for(auto _ : state){
+		int sum=0;
+		for(int i=0; i<NUM_WORDS; i++)
+			sum+=LSB(v[i]);
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations()*NUM_WORDS);
+	state.SetBytesProcessed(state.iterations()*NUM_WORDS*sizeof(BITBOARD));
+}
+
+template<int (*POPC)(const BITBOARD)>
+static void BM_popc64(benchmark::State& state){
+	vector<BITBOARD> v=random_words(false);
+	for(auto _ : state){
+		int sum=0;
+		for(int i=0; i<NUM_WORDS; i++)
+			sum+=POPC(v[i]);
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations()*NUM_WORDS);
+	state.SetBytesProcessed(state.iterations()*NUM_WORDS*sizeof(BITBOARD));
+}
+
+//arg: 0-random words, 1-single bit words
+BENCHMARK_TEMPLATE(BM_lsb64, BitBoard::lsb64_intrinsic)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_lsb64, BitBoard::lsb64_de_Bruijn)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_lsb64, BitBoard::lsb64_lup)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_lsb64, BitBoard::lsb64_mod)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_popc64, BitBoard::popc64);
+BENCHMARK_TEMPLATE(BM_popc64, BitBoard::popc64_lup);
+
+//////////////////////
+//
+// Bit scanning
+//
+//////////////////////
+
+template<class BitSet_t>
+static int scan(BitSet_t& bb, BBObject::scan_types sct){
+////////////////
+// enumerates the population of bb with the scan type sct (the loops of the README)
+// RETURNS the sum of the 1-bits found
+
+	int nBit, sum=0;
+	if(bb.init_scan(sct)==EMPTY_ELEM) return 0;						//sparse bit strings with no bitblocks
+	switch(sct){
+	case BBObject::NON_DESTRUCTIVE:
+		while((nBit=bb.next_bit())!=EMPTY_ELEM) sum+=nBit;
+		break;
+	case BBObject::NON_DESTRUCTIVE_REVERSE:
+		while((nBit=bb.previous_bit())!=EMPTY_ELEM) sum+=nBit;
+		break;
+	case BBObject::DESTRUCTIVE:
+		while((nBit=bb.next_bit_del())!=EMPTY_ELEM) sum+=nBit;
+		break;
+	case BBObject::DESTRUCTIVE_REVERSE:
+		while((nBit=bb.previous_bit_del())!=EMPTY_ELEM) sum+=nBit;
+		break;
+	default:
+		;
+	}
+return sum;
+}
+
+static size_t storage_bytes(const BitBoardN& bb)	{return bb.number_of_bitblocks()*sizeof(BITBOARD);}
+static size_t storage_bytes(const BitBoardS& bb)	{return bb.number_of_bitblocks()*sizeof(BitBoardS::elem_t);}
+
+template<class BitSet_t>
+static void BM_scan(benchmark::State& state){
+////////////////
+// args: population size, density (%), scan type
+// destructive scans restore the bit string from a copy outside the timed region
+
+	const int popsize=state.range(0);
+	const BBObject::scan_types sct=static_cast<BBObject::scan_types>(state.range(2));
+	const bool destructive=(sct==BBObject::DESTRUCTIVE || sct==BBObject::DESTRUCTIVE_REVERSE);
+
+	BitSet_t orig(popsize);
+	random_bitset(orig, popsize, state.range(1));
+	BitSet_t bb(orig);
+	const int pc=orig.popcn64();
+
+	for(auto _ : state){
+		if(destructive){
+			state.PauseTiming();
+			bb=orig;
+			state.ResumeTiming();
+		}
+		benchmark::DoNotOptimize(scan(bb, sct));
+	}
+
+	state.counters["time/bit"]=benchmark::Counter(pc, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+	state.SetBytesProcessed(state.iterations()*storage_bytes(orig));
+}
+
+static void scan_args(benchmark::internal::Benchmark* b){
+	b->ArgNames({"popsize", "density", "scan"});
+	for(int sct=BBObject::NON_DESTRUCTIVE; sct<=BBObject::DESTRUCTIVE_REVERSE; sct++)
+		for(int popsize : {1000, 10000, 100000, 1000000})
+			for(int density : {1, 10, 50})
+				b->Args({popsize, density, sct});
+}
+
+BENCHMARK_TEMPLATE(BM_scan, BBIntrin)->Apply(scan_args);
+BENCHMARK_TEMPLATE(BM_scan, BBSentinel)->Apply(scan_args);
+BENCHMARK_TEMPLATE(BM_scan, BBIntrinS)->Apply(scan_args);
+
+//////////////////////
+//
+// Transposition
+//
+//////////////////////
+
+static void BM_transpose64(benchmark::State& state){
+////////////////
+// 64x64 kernel of an instruction set (arg: BBKernel::isa_t)
+
+	BBKernel::isa_t isa=BBKernel::get_isa();
+	if(BBKernel::set_isa((BBKernel::isa_t)state.range(0))==-1){
+		state.SkipWithError("instruction set not supported");
+		return;
+	}
+	state.SetLabel(BBKernel::isa_name(BBKernel::get_isa()));
+
+	vector<BITBOARD> v=random_words(false);
+	for(auto _ : state){
+		for(int i=0; i<NUM_WORDS; i+=64)
+			BBKernel::bb_transpose64(&v[i]);
+		benchmark::ClobberMemory();
+	}
+	BBKernel::set_isa(isa);
+	state.SetBytesProcessed(state.iterations()*NUM_WORDS*sizeof(BITBOARD));
+}
+
+static void BM_transpose_matrix(benchmark::State& state){
+////////////////
+// square matrix (arg: order), by tiles (arg 1) or bit by bit (arg 0)
+
+	const int n=state.range(0);
+	BitMatrix m(n, n), mt(n, n);
+	for(int i=0; i<n; i++)
+		random_bitset(m[i], n, 10);
+
+	for(auto _ : state){
+		if(state.range(1)){
+			m.transpose(mt);
+		}else{
+			mt.erase_bit();
+			for(int i=0; i<n; i++)
+				for(int j=0; j<n; j++)
+					if(m.is_bit(i, j)) mt.set_bit(j, i);
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetBytesProcessed(state.iterations()*m.memory_bytes());
+}
+
+BENCHMARK(BM_transpose64)->DenseRange(BBKernel::SCALAR, BBKernel::AVX2);
+BENCHMARK(BM_transpose_matrix)->ArgNames({"n", "tiled"})->ArgsProduct({{1000, 5000}, {0, 1}});
+
+//////////////////////
+//
+// Parallel enumeration
+//
+//////////////////////
+
+static void BM_for_each_bit(benchmark::State& state){
+////////////////
+// clustered population (90% of the 1-bits in the first 5% of the bitblocks) with some work per 1-bit
+// args: threads, popcount balanced ranges with work stealing (1) or one even range of bitblocks per thread (0)
+
+	const int N=1000000;
+	const int nthreads=state.range(0);
+	BBIntrin bbi(N);
+	for(int i=0; i<N/20; i+=2) bbi.set_bit(i);
+	for(int i=N/20; i<N; i+=340) bbi.set_bit(i);
+
+	BBThreadPool pool(nthreads);
+	atomic<long long> sum(0);
+	auto fn=[&sum](int bit){
+		unsigned h=bit;
+		for(int k=0; k<200; k++) h=h*2654435761u+k;
+		sum+=h&1;
+	};
+
+	const BITBOARD* aBB=bbi.get_bitstring();
+	const int nBB=bbi.number_of_bitblocks();
+	for(auto _ : state){
+		if(state.range(1)){
+			BBParallel::for_each_bit(bbi, fn, false, pool);
+		}else{
+			pool.run(nBB, (nBB+nthreads-1)/nthreads, [&](int begin, int end){
+				for(int i=begin; i<end; i++)
+					for(BITBOARD bb=aBB[i]; bb; bb&=bb-1)
+						fn(WMUL(i)+BitBoard::lsb64_intrinsic(bb));
+			});
+		}
+	}
+	benchmark::DoNotOptimize(sum.load());
+	state.SetItemsProcessed(state.iterations()*bbi.popcn64());
+}
+
+BENCHMARK(BM_for_each_bit)->ArgNames({"threads", "balanced"})->ArgsProduct({{1, 2, 4}, {0, 1}})->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -11,30 +11,22 @@
 using namespace std;
 
 BitBoardN&  AND (const BitBoardN& lhs, const BitBoardN& rhs,  BitBoardN& res){
-	for(int i=0; i<lhs.m_nBB; i++){
-		res.m_aBB[i]=lhs.m_aBB[i] & rhs.m_aBB[i];
-	}
+	BBKernel::bb_and(res.m_aBB, lhs.m_aBB, rhs.m_aBB, lhs.m_nBB);
 return res;
 }
 
 BitBoardN&  OR	(const BitBoardN& lhs, const BitBoardN& rhs,  BitBoardN& res){
-	for(int i=0; i<lhs.m_nBB; i++){
-		res.m_aBB[i]=lhs.m_aBB[i] | rhs.m_aBB[i];
-	}
+	BBKernel::bb_or(res.m_aBB, lhs.m_aBB, rhs.m_aBB, lhs.m_nBB);
 return res;
 }
 
 BitBoardN&   AND (int first_block, const BitBoardN& lhs, const BitBoardN& rhs,  BitBoardN& res){
-	for(int i=first_block; i<lhs.m_nBB; i++){
-		res.m_aBB[i]=rhs.m_aBB[i] & lhs.m_aBB[i];
-	}
+	BBKernel::bb_and(res.m_aBB+first_block, lhs.m_aBB+first_block, rhs.m_aBB+first_block, lhs.m_nBB-first_block);
 return res;
 }
 
 BitBoardN&   AND (int first_block, int last_block, const BitBoardN& lhs, const BitBoardN& rhs,  BitBoardN& res){
-	for(int i=first_block; i<=last_block; i++){
-		res.m_aBB[i]=rhs.m_aBB[i] & lhs.m_aBB[i];
-	}
+	BBKernel::bb_and(res.m_aBB+first_block, lhs.m_aBB+first_block, rhs.m_aBB+first_block, last_block-first_block+1);
 return res;
 }
 
@@ -42,10 +34,7 @@ BitBoardN&  ERASE(const BitBoardN& lhs, const BitBoardN& rhs,  BitBoardN& res){
 /////////////
 // removes rhs FROM lhs
 
-	for(int i=0; i<lhs.m_nBB; i++){
-		res.m_aBB[i]=lhs.m_aBB[i] &~ rhs.m_aBB[i];
-	}
-
+	BBKernel::bb_andnot(res.m_aBB, lhs.m_aBB, rhs.m_aBB, lhs.m_nBB);
 return res;
 }
 
@@ -53,58 +42,74 @@ return res;
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
-BitBoardN::BitBoardN(int popsize /*1 based*/ , bool reset){
+BitBoardN::BitBoardN(int popsize /*1 based*/ , bool reset):m_alloc(BBAlloc::get_default()){
 			
 	m_nBB=INDEX_1TO1(popsize);
+	m_cap=m_nBB;
+	if(!(m_aBB=m_alloc->allocate(m_nBB))){
+			printf("Error al reservar memoria");
+			m_nBB=-1;
+			m_cap=0;
+	}
+	
+	//Sets to 0 all bits
+	if(reset) erase_bit();
+}
 
-#ifndef _MEM_ALIGNMENT
-	if(!(m_aBB= new BITBOARD[m_nBB])){
-#else
-	if(!(m_aBB = (BITBOARD*)_aligned_malloc(sizeof(BITBOARD)*m_nBB,_MEM_ALIGNMENT))){
-#endif
+BitBoardN::BitBoardN(int popsize /*1 based*/ , BBAlloc& alloc, bool reset):m_alloc(&alloc){
+///////////////////////////
+// bitblocks are reserved (and released) by alloc
+			
+	m_nBB=INDEX_1TO1(popsize);
+	m_cap=m_nBB;
+	if(!(m_aBB=m_alloc->allocate(m_nBB))){
 			printf("Error al reservar memoria");
 			m_nBB=-1;
+			m_cap=0;
 	}
 	
 	//Sets to 0 all bits
 	if(reset) erase_bit();
 }
 
-BitBoardN::BitBoardN(const BitBoardN& bbN){
+BitBoardN::BitBoardN(const BitBoardN& bbN):m_alloc(BBAlloc::get_default()){
 ///////////////////////////
-// copy constructor
+// copy constructor (the copy always uses the default allocator)
 
 	//allcoates memory
 	if(bbN.m_aBB==NULL || bbN.m_nBB<0 ){
 		m_nBB=-1;
+		m_cap=0;
 		m_aBB=NULL;
 	return;
 	}
 	
  	m_nBB=bbN.m_nBB;
-
-#ifndef _MEM_ALIGNMENT
-	m_aBB=new BITBOARD[m_nBB];
-#else
-	m_aBB = (BITBOARD*)_aligned_malloc(sizeof(BITBOARD)*m_nBB, _MEM_ALIGNMENT );
-#endif
+	m_cap=m_nBB;
+	m_aBB=m_alloc->allocate(m_nBB);
  
 	//copies bitblocks
 	for(int i=0; i<m_nBB; i++)
  				m_aBB[i]=bbN.m_aBB[i];
  }
 
-BitBoardN::BitBoardN(const vector<int>& v){
+BitBoardN::BitBoardN(BitBoardN&& bbN) noexcept :m_aBB(bbN.m_aBB), m_nBB(bbN.m_nBB), m_cap(bbN.m_cap), m_alloc(bbN.m_alloc){
+///////////////////////////
+// move constructor: takes over the bitblocks (and the allocator) of bbN, which is left empty
+
+	bbN.m_aBB=NULL;
+	bbN.m_nBB=EMPTY_ELEM;
+	bbN.m_cap=0;
+}
+
+BitBoardN::BitBoardN(const vector<int>& v):m_alloc(BBAlloc::get_default()){
 ///////////////////
 // vector numbers should be zero based (i.e v[0]=3, bit-index 3=1)
 
 	//Getting BB Size
 	m_nBB=INDEX_0TO1(*(max_element(v.begin(), v.end())) ) ; 
-#ifndef _MEM_ALIGNMENT
-	m_aBB=new BITBOARD[m_nBB];
-#else
-	m_aBB = (BITBOARD*)_aligned_malloc(sizeof(BITBOARD)*m_nBB, _MEM_ALIGNMENT );
-#endif
+	m_cap=m_nBB;
+	m_aBB=m_alloc->allocate(m_nBB);
 	erase_bit();
 	for(int i=0; i<v.size(); i++){
 		if(v[i]>=0)
@@ -114,7 +119,7 @@ BitBoardN::BitBoardN(const vector<int>& v){
 
 BitBoardN::~BitBoardN(){
 	if(m_aBB!=NULL){	
-		delete [] m_aBB;
+		m_alloc->deallocate(m_aBB, m_cap);
 	}
 	m_aBB=NULL;
 }
@@ -124,25 +129,10 @@ void BitBoardN::init(int popsize, const vector<int> &v){
 ///////////////////////////
 // values in vector are 1-bits in the bitboard (0 based)
 	
-	if(m_aBB!=NULL){
-#ifndef _MEM_ALIGNMENT
-		delete [] m_aBB;
-#else
-		_aligned_free(m_aBB);
-#endif
-		m_aBB=NULL;
-	}
-	
-	m_nBB=INDEX_1TO1(popsize); //((popsize-1)/WORD_SIZE)+1;
-	 
-#ifndef _MEM_ALIGNMENT
-	m_aBB= new BITBOARD[m_nBB];
-#else
-	m_aBB = (BITBOARD*)_aligned_malloc(sizeof(BITBOARD)*m_nBB,_MEM_ALIGNMENT);
-#endif
+	init(popsize, true);					//reuses storage if possible
+	if(m_aBB==NULL || m_nBB!=INDEX_1TO1(popsize)) return;		//memory could not be allocated
 
 	//sets bit conveniently
-	erase_bit();
 	for(int i=0; i<v.size(); i++){
 		if(v[i]>=0 && v[i]<popsize)
 						set_bit(v[i]);
@@ -165,25 +155,24 @@ const BITBOARD* BitBoardN::get_bitstring ()	const{
 
 void BitBoardN::init(int popsize, bool reset){
 //////////////////////
-// only way to change storage space once constructed
-
-	if(m_aBB!=NULL){
-#ifndef _MEM_ALIGNMENT
-		delete [] m_aBB;
-#else
-		_aligned_free(m_aBB);
-#endif
-		m_aBB=NULL;
-	}
-
-	//nBBs
-	m_nBB=INDEX_1TO1(popsize); 
+// changes the size of the bit string (with the allocator of the bit string)
+// storage is only reallocated if popsize exceeds capacity
+// (the bit string is left unchanged if memory cannot be allocated, e.g. views with BBNullAlloc)
 	
-#ifndef _MEM_ALIGNMENT
-	m_aBB= new BITBOARD[m_nBB];
-#else
-	m_aBB = (BITBOARD*)_aligned_malloc(sizeof(BITBOARD)*m_nBB,_MEM_ALIGNMENT);
-#endif
+	int nBB=INDEX_1TO1(popsize); 
+	if(m_aBB==NULL || nBB>m_cap){
+		BITBOARD* aBB=m_alloc->allocate(nBB);
+		if(aBB==NULL){
+			cerr<<"Error when allocating memory: BitBoardN::init"<<endl;
+			return;
+		}
+		if(m_aBB!=NULL){
+			m_alloc->deallocate(m_aBB, m_cap);
+		}
+		m_aBB=aBB;
+		m_cap=nBB;
+	}
+	m_nBB=nBB;
 
 	//Sets to 0
 	if(reset)
@@ -192,6 +181,55 @@ void BitBoardN::init(int popsize, bool reset){
 return ;
 }
 
+int BitBoardN::reserve(int popsize){
+//////////////////////
+// ensures capacity for popsize bits without changing size or contents
+//
+// RETURNS -1 if memory could not be allocated, 0 otherwise
+
+	int cap=INDEX_1TO1(popsize);
+	if(m_aBB!=NULL && cap<=m_cap) return 0;
+		
+	BITBOARD* aBB=m_alloc->allocate(cap);
+	if(aBB==NULL){
+		cerr<<"Error when allocating memory: BitBoardN::reserve"<<endl;
+		return -1;
+	}
+
+	if(m_aBB!=NULL){
+		for(int i=0; i<m_nBB; i++)
+				aBB[i]=m_aBB[i];
+		m_alloc->deallocate(m_aBB, m_cap);
+	}else m_nBB=0;
+
+	m_aBB=aBB;
+	m_cap=cap;
+return 0;
+}
+
+int BitBoardN::resize(int popsize){
+//////////////////////
+// changes the size of the bit string preserving its contents (new bits are 0)
+// storage grows geometrically and is never released on shrinking
+//
+// RETURNS -1 if memory could not be allocated, 0 otherwise
+
+	int nBB=(popsize>0)? INDEX_1TO1(popsize) : 0;
+	if(m_aBB==NULL || nBB>m_cap){
+		int cap=(nBB>2*m_cap)? nBB : 2*m_cap;
+		if(reserve(cap*WORD_SIZE)==-1) return -1;
+	}
+
+	for(int i=m_nBB; i<nBB; i++)
+			m_aBB[i]=ZERO;
+	m_nBB=nBB;
+
+	//removes bits beyond popsize in the last bitblock
+	if(nBB>0 && WMOD(popsize))
+		m_aBB[nBB-1]&=~Tables::mask_left[WMOD(popsize-1)];
+return 0;
+}
+
 
 
 //void BitBoardN::add_bitstring_left(){
@@ -216,22 +254,19 @@ return ;
 /////////////////////////
 
 BitBoardN& BitBoardN::operator &=	(const BitBoardN& bbn){
-	for(int i=0; i<m_nBB; i++)
-				m_aBB[i]&=bbn.m_aBB[i];
+	BBKernel::bb_and(m_aBB, m_aBB, bbn.m_aBB, m_nBB);
 return *this;
 }
 
 BitBoardN& BitBoardN::operator |=	(const BitBoardN& bbn){
-	for(int i=0; i<m_nBB; i++)
-				m_aBB[i]|=bbn.m_aBB[i];
+	BBKernel::bb_or(m_aBB, m_aBB, bbn.m_aBB, m_nBB);
 return *this;
 }
 
 BitBoardN&  BitBoardN::AND_EQ (int first_block, const BitBoardN& rhs ){
 //////////////////////
 // mask in range [first_block , END[
-	for(int i=first_block; i<m_nBB; i++)
-				m_aBB[i]&=rhs.m_aBB[i];
+	BBKernel::bb_and(m_aBB+first_block, m_aBB+first_block, rhs.m_aBB+first_block, m_nBB-first_block);
 return *this;
 }
 
@@ -240,23 +275,20 @@ BitBoardN&  BitBoardN::OR_EQ (int first_block, const BitBoardN& rhs ){
 //////////////////////
 // mask in range [first_block , END[
 
-	for(int i=first_block; i<m_nBB; i++)
-				m_aBB[i]|=rhs.m_aBB[i];
+	BBKernel::bb_or(m_aBB+first_block, m_aBB+first_block, rhs.m_aBB+first_block, m_nBB-first_block);
 return *this;
 }
 
 
 
 BitBoardN& BitBoardN::operator ^=	(const BitBoardN& bbn){
-	for(int i=0; i<m_nBB; i++)
-				m_aBB[i]^=bbn.m_aBB[i];
+	BBKernel::bb_xor(m_aBB, m_aBB, bbn.m_aBB, m_nBB);
 return *this;
 }
 
 
 BitBoardN& BitBoardN::flip	(){
-	for(int i=0; i<m_nBB; i++)
-			m_aBB[i]=~m_aBB[i];
+	BBKernel::bb_not(m_aBB, m_aBB, m_nBB);
 return *this;
 }
 
@@ -317,22 +349,18 @@ void BitBoardN::to_vector(vector<int>& vl ) const {
 //////////////////////
 // copies bit string to vector 
 
-	vl.clear();
-
-	int v=EMPTY_ELEM;
-	while(true){
-		v=next_bit(v);
-		if(v==EMPTY_ELEM) break;
-
-		vl.push_back(v);
-	}
+	int pc=BBKernel::bb_popc(m_aBB, m_nBB);
+	vl.resize(pc);
+	if(pc) BitBoardN::decode(&vl[0], pc);				//all the bit string (also for sentinel types)
 }
 
 
 BitBoardN& BitBoardN::operator =  (const BitBoardN& bbN){
+	if(this==&bbN) return *this;
 	if(m_nBB!=bbN.m_nBB){
-		//allocates memory
-		init(bbN.m_nBB,false);		
+		//allocates memory if capacity is exceeded (init expects the number of bits)
+		init(bbN.m_nBB*WORD_SIZE,false);		
+		if(m_nBB!=bbN.m_nBB) return *this;		//memory could not be allocated
 	}
 
 	for(int i=0; i<m_nBB; i++)
@@ -340,5 +368,20 @@ BitBoardN& BitBoardN::operator =  (const BitBoardN& bbN){
 return *this;
 }
 
+BitBoardN& BitBoardN::operator =  (BitBoardN&& bbN) noexcept{
+///////////////////////////
+// move assignment: releases current storage and takes over the bitblocks (and the allocator) of bbN
+// (storage owned elsewhere, BBNullAlloc, is never replaced: the bits are copied)
+
+	if(this==&bbN) return *this;
+	if(m_alloc==&BBNullAlloc::instance()) return operator=((const BitBoardN&)bbN);
+	if(m_aBB!=NULL){
+		m_alloc->deallocate(m_aBB, m_cap);
+	}
+	m_aBB=bbN.m_aBB;	m_nBB=bbN.m_nBB;	m_cap=bbN.m_cap;	m_alloc=bbN.m_alloc;
+	bbN.m_aBB=NULL;		bbN.m_nBB=EMPTY_ELEM;	bbN.m_cap=0;
+return *this;
+}
+
 
 
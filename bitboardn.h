@@ -24,6 +24,9 @@
 
 #include "bbobject.h"
 #include "bitboard.h"	
+#include "bbkernel.h"
+#include "bballoc.h"
+#include "bbiterator.h"
 #include <vector>	
 
 using namespace std;
@@ -34,6 +37,7 @@ using namespace std;
 //
 // Manages bit strings greater than WORD_SIZE 
 // Does not use intrinsics nor does it cache information for very fast bitscanning
+// Bulk set operations (AND, OR, ERASE, flip etc.) are vectorized (see BBKernel)
 //
 ///////////////////////////////////
 class BitBoardN:public BBObject{
@@ -52,15 +56,20 @@ public:
 
 
 //constructors, initialization, assignment
-	 BitBoardN						(): m_nBB(EMPTY_ELEM),m_aBB(NULL){};										
+	 BitBoardN						(): m_aBB(NULL),m_nBB(EMPTY_ELEM),m_cap(0),m_alloc(BBAlloc::get_default()){};										
 explicit  BitBoardN					(int popsize /*1 based*/, bool reset=true);	
+	 BitBoardN						(int popsize /*1 based*/, BBAlloc& alloc, bool reset=true);		//bitblocks reserved by alloc
 	 BitBoardN						(const BitBoardN& bbN);
+	 BitBoardN						(BitBoardN&& bbN) noexcept;										//bbN is left empty
 	 BitBoardN						(const std::vector<int>& v);
 virtual	~BitBoardN					();
 		 
-	void init						(int popsize, bool reset=true);										
+	void init						(int popsize, bool reset=true);										//reallocates only if capacity is exceeded
 	void init						(int popsize, const vector<int> & );								
+	int  reserve					(int popsize);														//capacity for popsize bits, keeps contents
+	int  resize						(int popsize);														//keeps contents, grows geometrically
 virtual	BitBoardN& operator =		(const BitBoardN& );	
+	BitBoardN& operator =			(BitBoardN&& ) noexcept;
 
 /////////////////////
 //setters and getters (will not allocate memory)
@@ -68,9 +77,19 @@ virtual	BitBoardN& operator =		(const BitBoardN& );
 	BITBOARD* get_bitstring			();
 	const BITBOARD* get_bitstring	()			const;
 	int number_of_bitblocks			()			const {return m_nBB;}
+	int capacity					()			const {return m_cap;}								//in bitblocks
+	BBAlloc* get_allocator			()			const {return m_alloc;}
 const BITBOARD get_bitboard			(int block) const {return m_aBB[block];}
 	BITBOARD& get_bitboard			(int block)		  {return m_aBB[block];}
 
+//////////////////////////////
+// Range-for iteration over 1-bits (state in the iterator, see bbiterator.h)
+	typedef BBBitRange<BBDenseBlock, false> bit_range;
+	typedef BBBitRange<BBDenseBlock, true>  bit_range_reverse;
+
+	bit_range bits					()			const {return bit_range(m_aBB, 0, (m_nBB>0)? m_nBB-1 : -1);}					//empty range if there is no storage
+	bit_range_reverse bits_reverse	()			const {return bit_range_reverse(m_aBB, 0, (m_nBB>0)? m_nBB-1 : -1);}
+
 //////////////////////////////
 // Bitscanning
 
@@ -87,6 +106,12 @@ inline int previous_bit		(int nbit)	const;					//lookup
 // Popcount
 virtual	inline int popcn64	()						const;		//lookup 
 virtual	inline int popcn64	(int nBit/* 0 based*/)	const;
+
+	//fused population count of set operations (no intermediate bit string)
+virtual	inline int popcount_and		(const BitBoardN& rhs)	const;		//|this & rhs|
+virtual	inline int popcount_andnot	(const BitBoardN& rhs)	const;		//|this &~ rhs|
+virtual	inline int popcount_or		(const BitBoardN& rhs)	const;		//|this | rhs|
+virtual	inline int popcount_xor		(const BitBoardN& rhs)	const;		//|this ^ rhs|
 /////////////////////
 //Set/Delete Bits 
 inline	void  init_bit				(int bit);	
@@ -137,12 +162,15 @@ inline virtual bool is_empty		(int nBBL, int nBBH)				const;
 	string to_string		();
 	
 	void to_vector			(std::vector<int>& )				const;
+virtual	inline int decode		(int* out, int max)					const;			//1-bits to out (at most max), returns the number written
 	
 ////////////////////////
 //Member data
 protected:
 	BITBOARD* m_aBB;
 	int m_nBB;				//number of BITBOARDS (1 based)
+	int m_cap;				//number of BITBOARDS allocated (m_cap>=m_nBB)
+	BBAlloc* m_alloc;		//allocator of m_aBB (aligned to _MEM_ALIGNMENT by default)
 };
 
 inline int BitBoardN::msbn64() const{
@@ -431,8 +459,7 @@ inline
 void  BitBoardN::set_bit (const BitBoardN& bb_add){
 //////////////
 // copies 1-bits (equivalent to OR, set_union etc)
-	for(int i=0; i<m_nBB; i++)	
-		m_aBB[i]|=bb_add.m_aBB[i];
+	BBKernel::bb_or(m_aBB, m_aBB, bb_add.m_aBB, m_nBB);
 }
 
 inline
@@ -576,6 +603,30 @@ return npc;
 }
 
 
+inline int BitBoardN::popcount_and (const BitBoardN& rhs) const{
+/////////////////////////
+// population of the intersection with rhs (same as popcn64 of AND without the temporary bit string)
+	return BBKernel::bb_popc_and(m_aBB, rhs.m_aBB, m_nBB);
+}
+
+inline int BitBoardN::popcount_andnot (const BitBoardN& rhs) const{
+	return BBKernel::bb_popc_andnot(m_aBB, rhs.m_aBB, m_nBB);
+}
+
+inline int BitBoardN::popcount_or (const BitBoardN& rhs) const{
+	return BBKernel::bb_popc_or(m_aBB, rhs.m_aBB, m_nBB);
+}
+
+inline int BitBoardN::popcount_xor (const BitBoardN& rhs) const{
+	return BBKernel::bb_popc_xor(m_aBB, rhs.m_aBB, m_nBB);
+}
+
+inline int BitBoardN::decode (int* out, int max) const{
+/////////////////////////
+// writes the 1-bits in increasing order in one pass (see BBKernel::bb_decode)
+	return BBKernel::bb_decode(m_aBB, m_nBB, 0, out, max);
+}
+
 inline int BitBoardN::single_disjoint (const BitBoardN& rhs, int& vertex) const{
 /////////////////////
 // PARAMS 
@@ -621,8 +672,7 @@ BitBoardN& BitBoardN::erase_bit (const BitBoardN& bbn){
 //////////////////////////////
 // deletes bbn from current bitstring
 
-	for(int i=0; i<m_nBB; i++)
-			m_aBB[i] &= ~ bbn.m_aBB[i];
+	BBKernel::bb_andnot(m_aBB, m_aBB, bbn.m_aBB, m_nBB);
 return *this;
 }
 
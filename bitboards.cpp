@@ -4,6 +4,7 @@
 
 #include "bitboards.h"
 #include "bbalg.h"
+#include "bitboardn.h"
 #include <iostream>
 #include <sstream>
 
@@ -18,7 +19,7 @@ int BitBoardS::nElem=EMPTY_ELEM;
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
-BitBoardS::BitBoardS(int size /*1 based*/, bool is_popsize ){
+BitBoardS::BitBoardS(int size /*1 based*/, bool is_popsize ):m_compact(false){
 	(is_popsize)? m_MAXBB=INDEX_1TO1(size) : m_MAXBB=size;
 	m_aBB.reserve(DEFAULT_CAPACITY);							//*** check efficiency
 }
@@ -28,6 +29,7 @@ BitBoardS::BitBoardS (const BitBoardS& bbS){
 // copies state
 	m_aBB=bbS.m_aBB;
 	m_MAXBB=bbS.m_MAXBB;
+	m_compact=bbS.m_compact;
 }
 
 int BitBoardS::init (int size, bool is_popsize){
@@ -50,6 +52,98 @@ void BitBoardS::sort (){
 	std::sort(m_aBB.begin(), m_aBB.end(), elem_less());
 }	
 
+static void radix_sort (vector<int>& v, vector<int>& tmp){
+///////////////////
+// LSD radix sort of non-negative integers, one pass per significant byte
+
+	int maxv=0;
+	for(int i=0; i<v.size(); i++)
+		if(v[i]>maxv) maxv=v[i];
+
+	tmp.resize(v.size());
+	for(int shift=0; shift<32 && (maxv>>shift)>0; shift+=8){
+		int count[257]={0};
+		for(int i=0; i<v.size(); i++)
+			count[((v[i]>>shift)&0xFF)+1]++;
+		for(int d=0; d<256; d++)
+			count[d+1]+=count[d];
+		for(int i=0; i<v.size(); i++)
+			tmp[count[(v[i]>>shift)&0xFF]++]=v[i];
+		v.swap(tmp);
+	}
+}
+
+int BitBoardS::init_sorted (const int* bits, int n){
+///////////////////
+// sets the 1-bits of a non-decreasing sequence and clears the rest, appending blocks in one pass
+// (if the population size is not defined it is taken from the last bit)
+//
+// RETURNS -1 if the sequence is not sorted or outside the population (the bit string is then empty)
+
+	m_aBB.clear();
+	if(n<=0) return 0;
+	if(bits[0]<0 || (m_MAXBB!=EMPTY_ELEM && WDIV(bits[n-1])>=m_MAXBB)){
+		cerr<<"bits outside population limit: ["<<bits[0]<<", "<<bits[n-1]<<"]"<<endl;
+		return -1;
+	}
+
+	int span=WDIV(bits[n-1])-WDIV(bits[0])+1;						//non positive if unsorted
+	if(span>0) m_aBB.reserve(min(n, span));
+	int prev=bits[0];
+	for(int i=0; i<n; i++){
+		if(bits[i]<prev){
+			cerr<<"unsorted sequence at position: "<<i<<endl;
+			m_aBB.clear();
+			return -1;
+		}
+		prev=bits[i];
+
+		int index=WDIV(bits[i]);
+		if(m_aBB.empty() || m_aBB.back().index!=index)
+			m_aBB.push_back(elem(index, ZERO));
+		m_aBB.back().bb|=Tables::mask[WMOD(bits[i])];
+	}
+
+	if(m_MAXBB==EMPTY_ELEM) m_MAXBB=m_aBB.back().index+1;
+return 0;
+}
+
+int BitBoardS::init_unsorted (const int* bits, int n){
+///////////////////
+// sets the 1-bits of a sequence in any order (O(n) radix sort) and clears the rest
+//
+// RETURNS -1 if a bit is negative or outside the population
+
+	vector<int> v(bits, bits+n), tmp;
+	for(int i=0; i<n; i++){
+		if(v[i]<0){
+			cerr<<"negative bit: "<<v[i]<<endl;
+			m_aBB.clear();
+			return -1;
+		}
+	}
+	radix_sort(v, tmp);
+return init_sorted(v.data(), n);
+}
+
+int BitBoardS::init_dense (const BitBoardN& bbn){
+///////////////////
+// copies the non-empty blocks of a dense bit string (the population size is that of bbn)
+
+	const BITBOARD* aBB=bbn.get_bitstring();
+	const int nBB=bbn.number_of_bitblocks();
+	int nElem=0;
+	for(int i=0; i<nBB; i++)
+		if(aBB[i]) nElem++;
+
+	m_aBB.clear();
+	m_aBB.reserve(nElem);
+	m_MAXBB=nBB;
+	for(int i=0; i<nBB; i++)
+		if(aBB[i]) m_aBB.push_back(elem(i, aBB[i]));
+return 0;
+}
+
 int	 BitBoardS::set_bit	(int low, int high){
 ///////////////////
 // sets bits to one in the corresponding CLOSED range
@@ -454,63 +548,95 @@ return 0;
 BitBoardS&  BitBoardS::erase_bit (const BitBoardS& rhs ){
 ////////////////////
 // removes 1-bits from current object (equialent to set_difference)
-	int i1=0, i2=0;
-	while(true){
-		//exit condition I
-		if(i1==m_aBB.size() || i2==rhs.m_aBB.size() ){		//size should be the same
-					return *this;
-		}
-
-		//update before either of the bitstrings has reached its end
-		if(m_aBB[i1].index==rhs.m_aBB[i2].index){
-			m_aBB[i1].bb&=~rhs.m_aBB[i2].bb;
-			i1++, i2++; 
-		}else if(m_aBB[i1].index<rhs.m_aBB[i2].index){
-			i1++;
-		}else if(rhs.m_aBB[i2].index<m_aBB[i1].index){
-			i2++;
-		}
+// (in auto compaction mode empty blocks are removed in the same pass)
+
+	const int n1=m_aBB.size(), n2=rhs.m_aBB.size();
+	int i2=0, n=0;
+	for(int i1=0; i1<n1; i1++){
+		for(; i2<n2 && rhs.m_aBB[i2].index<m_aBB[i1].index; i2++){}
+		if(i2==n2 && !m_compact) break;						//nothing left to remove
+
+		BITBOARD bb=m_aBB[i1].bb;
+		if(i2<n2 && rhs.m_aBB[i2].index==m_aBB[i1].index)
+			bb&=~rhs.m_aBB[i2].bb;
+		if(!m_compact)
+			m_aBB[i1].bb=bb;
+		else if(bb)
+			m_aBB[n++]=elem(m_aBB[i1].index, bb);
 	}
+	if(m_compact) m_aBB.resize(n);
 
 return *this;
 }
 
+int BitBoardS::compact(){
+////////////////////
+// removes empty blocks in place (no reallocation)
+//
+// RETURNS the number of blocks removed
+
+	int n=0;
+	const int nBB=m_aBB.size();
+	for(int i=0; i<nBB; i++){
+		if(m_aBB[i].bb){
+			if(n!=i) m_aBB[n]=m_aBB[i];
+			n++;
+		}
+	}
+	m_aBB.resize(n);
+return (nBB-n);
+}
+
 BitBoardS& BitBoardS::operator &= (const BitBoardS& rhs){
 ///////////////////
 // AND mask in place
-
-	int i1=0, i2=0;
-	while(true){
-		//exit conditions 
-		if(i1==m_aBB.size() ){		//size should be the same
-					return *this;
-		}else if(i2==rhs.m_aBB.size()){  //fill with zeros from last block in rhs onwards
-			for(; i1<m_aBB.size(); i1++)
-				m_aBB[i1].bb=ZERO;
-			return *this;
+//
+// REMARKS: 
+// 1-for skewed sizes the blocks of the smaller operand are searched by galloping.
+//   If this bitstring is the larger one, the blocks between matches are cleared (lax mode)
+//   so that the blocks (and their positions) do not depend on the sizes of the operands
+// 2-in auto compaction mode empty blocks are removed in the same pass (no reallocation)
+
+	const int n1=m_aBB.size(), n2=rhs.m_aBB.size();
+	int n=0;												//blocks kept
+	if(is_skewed(n1, n2) && n1>n2){
+		int i1=0;
+		for(int i2=0; i2<n2 && i1<n1; i2++){
+			int pos=gallop(m_aBB, i1, rhs.m_aBB[i2].index);
+			if(!m_compact)
+				for(; i1<pos; i1++) m_aBB[i1].bb=ZERO;		//not in rhs
+			i1=pos;
+			if(i1<n1 && m_aBB[i1].index==rhs.m_aBB[i2].index){
+				BITBOARD bb=m_aBB[i1].bb & rhs.m_aBB[i2].bb;
+				if(!m_compact)
+					m_aBB[i1].bb=bb;
+				else if(bb)
+					m_aBB[n++]=elem(m_aBB[i1].index, bb);
+				i1++;
+			}
 		}
+		if(m_compact)
+			m_aBB.resize(n);
+		else
+			for(; i1<n1; i1++) m_aBB[i1].bb=ZERO;			//from the last block in rhs onwards
+		return *this;
+	}
 
-		//update before either of the bitstrings has reached its end
-		if(m_aBB[i1].index<rhs.m_aBB[i2].index){
-			m_aBB[i1].bb=0;
-			i1++;
-		}else if (rhs.m_aBB[i2].index<m_aBB[i1].index){
-			i2++;
-		}else{
-			m_aBB[i1].bb &= rhs.m_aBB[i2].bb;
-			i1++, i2++; 
-		}
-
-		/*if(m_aBB[i1].index==rhs.m_aBB[i2].index){
-			m_aBB[i1].bb &= rhs.m_aBB[i2].bb;
-			i1++, i2++; 
-		}else if(m_aBB[i1].index<rhs.m_aBB[i2].index){
-			m_aBB[i1].bb=0;
-			i1++;
-		}else if(rhs.m_aBB[i2].index<m_aBB[i1].index){
-			i2++;
-		}*/
+	const bool gallop_rhs=is_skewed(n1, n2);
+	int i2=0;
+	for(int i1=0; i1<n1; i1++){
+		if(gallop_rhs)
+			i2=gallop(rhs.m_aBB, i2, m_aBB[i1].index);
+		else
+			for(; i2<n2 && rhs.m_aBB[i2].index<m_aBB[i1].index; i2++){}
+
+		BITBOARD bb=(i2<n2 && rhs.m_aBB[i2].index==m_aBB[i1].index)? (m_aBB[i1].bb & rhs.m_aBB[i2].bb) : ZERO;	//zero from the last block in rhs onwards
+		if(!m_compact)
+			m_aBB[i1].bb=bb;
+		else if(bb)
+			m_aBB[n++]=elem(m_aBB[i1].index, bb);
 	}
+	if(m_compact) m_aBB.resize(n);
 
 return *this;
 }
@@ -520,22 +646,38 @@ BitBoardS& BitBoardS::operator |= (const BitBoardS& rhs){
 // OR mask in place
 // date:10/02/2015
 // last_update: 10/02/2015
+//
+// REMARKS: the blocks of rhs are located by galloping; blocks of rhs which are not
+// in this bitstring are then added by a single backward merge
 
-	int i1=0, i2=0;
-	while(true){
-		//exit conditions 
-		if(i1==m_aBB.size() || i2==rhs.m_aBB.size() ){				//size should be the same
-					return *this;
-		}
-
-		//update before either of the bitstrings has reached its end
-		if(m_aBB[i1].index<rhs.m_aBB[i2].index){
-			i1++;
-		}else if(rhs.m_aBB[i2].index<m_aBB[i1].index){
-			i2++;
+	const int n1=m_aBB.size(), n2=rhs.m_aBB.size();
+	
+	//common blocks
+	int i1=0, nNew=0;
+	for(int i2=0; i2<n2; i2++){
+		if(n1>GALLOP_RATIO*n2)
+			i1=gallop(m_aBB, i1, rhs.m_aBB[i2].index);
+		else
+			for(; i1<n1 && m_aBB[i1].index<rhs.m_aBB[i2].index; i1++){}
+		if(i1<n1 && m_aBB[i1].index==rhs.m_aBB[i2].index)
+			m_aBB[i1].bb|=rhs.m_aBB[i2].bb;
+		else
+			nNew++;
+	}
+	if(nNew==0) return *this;
+
+	//new blocks: backward merge in place
+	m_aBB.resize(n1+nNew);
+	int pos=n1+nNew-1, i2=n2-1;
+	i1=n1-1;
+	while(i2>=0){
+		if(i1>=0 && m_aBB[i1].index>rhs.m_aBB[i2].index){
+			m_aBB[pos--]=m_aBB[i1--];
+		}else if(i1>=0 && m_aBB[i1].index==rhs.m_aBB[i2].index){		//already ORed
+			m_aBB[pos--]=m_aBB[i1--];
+			i2--;
 		}else{
-			m_aBB[i1].bb |= rhs.m_aBB[i2].bb;
-			i1++, i2++; 
+			m_aBB[pos--]=rhs.m_aBB[i2--];
 		}
 	}
 
@@ -734,6 +876,7 @@ BitBoardS& BitBoardS::operator = (const BitBoardS& bbs){
 	if(this!=&bbs){
 		this->m_aBB=bbs.m_aBB;
 		this->m_MAXBB=bbs.m_MAXBB;
+		this->m_compact=bbs.m_compact;
 	}
 
 return *this;
@@ -753,8 +896,29 @@ BitBoardS&  OR	(const BitBoardS& lhs, const BitBoardS& rhs,  BitBoardS& res){
 // 	
 // REMARKS: does not check for null information
 
-	int i1=0, i2=0;
 	res.erase_bit();		//experimental (and simplest solution)
+
+	//skewed sizes: the blocks of the larger operand between two blocks of the smaller one are copied in bulk
+	if(BitBoardS::is_skewed(lhs.m_aBB.size(), rhs.m_aBB.size())){
+		const BitBoardS::velem& small=(lhs.m_aBB.size()<rhs.m_aBB.size())? lhs.m_aBB : rhs.m_aBB;
+		const BitBoardS::velem& big=(lhs.m_aBB.size()<rhs.m_aBB.size())? rhs.m_aBB : lhs.m_aBB;
+		res.m_aBB.reserve(small.size()+big.size());
+		int ib=0;
+		for(int is=0; is<small.size(); is++){
+			int next=BitBoardS::gallop(big, ib, small[is].index);
+			res.m_aBB.insert(res.m_aBB.end(), big.begin()+ib, big.begin()+next);
+			ib=next;
+			if(ib<big.size() && big[ib].index==small[is].index){
+				res.m_aBB.push_back(BitBoardS::elem(small[is].index, small[is].bb | big[ib].bb));
+				ib++;
+			}else
+				res.m_aBB.push_back(small[is]);
+		}
+		res.m_aBB.insert(res.m_aBB.end(), big.begin()+ib, big.end());
+		return res;
+	}
+
+	int i1=0, i2=0;
 	while(true){
 		//exit condition I
 		if(i1==lhs.m_aBB.size()){
@@ -846,14 +1010,23 @@ void BitBoardS::to_vector (std::vector<int>& vl)const{
 //////////////////////
 // copies bit string to vector 
 //
-	vl.clear();
+	int pc=0;
+	for(int i=0; i<m_aBB.size(); i++)
+		pc+=BitBoard::popc64(m_aBB[i].bb);
+	vl.resize(pc);
+	if(pc) decode(&vl[0], pc);
+}
 
-	int v=EMPTY_ELEM;
-	while(true){
-		v=next_bit(v);
-		if(v==EMPTY_ELEM) break;
+int BitBoardS::decode (int* out, int max) const{
+//////////////////////
+// writes the 1-bits in increasing order in one pass (see BBKernel::bb_decode)
+//
+// RETURNS the number of 1-bits written (at most max)
 
-		vl.push_back(v);
+	int n=0;
+	for(int i=0; i<m_aBB.size() && n<max; i++){
+		n+=BBKernel::bb_decode(&m_aBB[i].bb, 1, WMUL(m_aBB[i].index), out+n, max-n);
 	}
+return n;
 }
 
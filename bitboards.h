@@ -23,6 +23,8 @@
 
 #include "bbobject.h"
 #include "bitboard.h"	
+#include "bbiterator.h"
+#include "bbkernel.h"
 #include <vector>	
 #include <algorithm>
 #include <functional>
@@ -31,9 +33,11 @@
 using namespace std;
 
 #define DEFAULT_CAPACITY	 2		//initial reserve of bit blocks for any new sparse bitstring (possibly remove)
+#define GALLOP_RATIO		32		//set operations gallop (exponential search) over the larger operand when it has this many times more blocks
 
 /*template<class T>
 class Graph;*/
+class BitBoardN;
  
 /////////////////////////////////
 //
@@ -44,6 +48,9 @@ class Graph;*/
 
 class BitBoardS: public BBObject{
 	//template <class T> friend  class Graph;
+	friend class BitBoardH;																					//conversion to hybrid containers
+	friend class BitBoardSA;																				//conversion to structure of arrays layout
+	friend class BBFileView;																				//loading of rows from binary files
 public:
 	struct elem_t{
 		int index;
@@ -80,7 +87,7 @@ public:
 	friend BitBoardS&  ERASE		(const BitBoardS& lhs, const BitBoardS& rhs,  BitBoardS& res);			//removes rhs from lhs
 
 
-	BitBoardS						():m_MAXBB(EMPTY_ELEM){}												//is this necessary?											
+	BitBoardS						():m_MAXBB(EMPTY_ELEM), m_compact(false){}												//is this necessary?											
 explicit BitBoardS					(int size, bool is_popsize=true );										//popsize is 1-based
 	BitBoardS						(const BitBoardS& );	
 virtual ~BitBoardS					(){clear();}	
@@ -102,6 +109,14 @@ virtual ~BitBoardS					(){clear();}
 	velem_it  end					(){return m_aBB.end();}
 	velem_cit  begin				()	const {return m_aBB.cbegin();}
 	velem_cit  end					()  const {return m_aBB.cend();}
+
+//////////////////////////////
+// Range-for iteration over 1-bits (state in the iterator, see bbiterator.h)
+	typedef BBBitRange<BBSparseBlock<elem>, false> bit_range;
+	typedef BBBitRange<BBSparseBlock<elem>, true>  bit_range_reverse;
+
+	bit_range bits					()	const {return bit_range(m_aBB.data(), 0, (int)m_aBB.size()-1);}
+	bit_range_reverse bits_reverse	()	const {return bit_range_reverse(m_aBB.data(), 0, (int)m_aBB.size()-1);}
 //////////////////////////////
 // Bitscanning
 
@@ -136,6 +151,13 @@ inline	int   set_bit				(int nbit);															//ordered insertion by bit blo
 		int	  set_bit				(int lbit, int rbit);												//CLOSED range
 BitBoardS&    set_bit				(const BitBoardS& bb_add);											//OR
 
+		//bulk construction in one linear pass (clear the rest, -1 on error)
+		int	  init_sorted			(const int* bits, int n);											//non-decreasing 1-bits (duplicates allowed)
+		int	  init_sorted			(const vector<int>& bits)	{return init_sorted(bits.data(), bits.size());}
+		int	  init_unsorted			(const int* bits, int n);											//any order (radix sorted internally)
+		int	  init_unsorted			(const vector<int>& bits)	{return init_unsorted(bits.data(), bits.size());}
+		int	  init_dense			(const BitBoardN& bbn);												//non-empty blocks of a dense bit string
+
 BitBoardS&  set_block				(int first_block, const BitBoardS& bb_add);							//OR:closed range
 BitBoardS&  set_block				(int first_block, int last_block, const BitBoardS& rhs);			//OR:closed range
 		
@@ -144,6 +166,9 @@ inline	velem_it  erase_bit			(int nbit, velem_it from_it);
 		int	  erase_bit				(int lbit, int rbit);
 		int	  clear_bit				(int lbit, int rbit);					//deallocates blocks
 		void  shrink_to_fit			(){m_aBB.shrink_to_fit();}
+		int	  compact				();										//removes empty blocks (no reallocation), returns the number removed
+		void  set_auto_compact		(bool compact=true)		{m_compact=compact;}		//opt-in: erase and AND operations remove the blocks they empty
+		bool  is_auto_compact		()				const	{return m_compact;}
 		void  erase_bit				() {m_aBB.clear();}						//clears all bit blocks
 BitBoardS&    erase_bit				(const BitBoardS&);				
 
@@ -170,11 +195,17 @@ virtual	void print					(ostream& = cout, bool show_pc = true) const;
 	string to_string				();
 	
 	void to_vector					(std::vector<int>& )	const;
+	int decode						(int* out, int max)		const;			//1-bits to out (at most max), returns the number written
+
+protected:
+inline static int gallop			(const velem& v, int from, int block_index);					//first position>=from with index>=block_index (exponential search)
+inline static bool is_skewed		(int n1, int n2)	{return (n1>GALLOP_RATIO*n2 || n2>GALLOP_RATIO*n1);}
 ////////////////////////
 //Member data
 protected:
 	velem m_aBB;					//a vector of sorted non-empty bit blocks
 	int m_MAXBB;					//maximum possible number of elements
+	bool m_compact;					//auto compaction mode: set operations remove the blocks they empty
 };
 
 
@@ -221,14 +252,49 @@ bool BitBoardS::is_empty ()	const{
 return true;
 }
 
+int BitBoardS::gallop (const velem& v, int from, int block_index){
+///////////////////
+// exponential search from the position from, followed by a binary search in the last step 
+// O(log d), d the distance to the position found
+//
+// RETURNS the first position>=from with index>=block_index (size if none)
+
+	const int n=v.size();
+	if(from>=n || v[from].index>=block_index) return from;
+
+	int lo=from, step=1;											//v[lo].index<block_index
+	while(lo+step<n && v[lo+step].index<block_index){
+		lo+=step;
+		step<<=1;
+	}
+	int hi=(lo+step<n)? lo+step : n;
+return (lower_bound(v.begin()+lo+1, v.begin()+hi, elem(block_index), elem_less())-v.begin());
+}
+
 inline
 bool BitBoardS::is_disjoint	(const BitBoardS& rhs) const{
 ///////////////////
 // true if there are no bits in common 
+// (the blocks of the smaller operand are searched by galloping when the sizes are skewed)
+
+	const int n1=m_aBB.size(), n2=rhs.m_aBB.size();
+	if(is_skewed(n1, n2)){
+		const velem& small=(n1<n2)? m_aBB : rhs.m_aBB;
+		const velem& big=(n1<n2)? rhs.m_aBB : m_aBB;
+		int ib=0;
+		for(int is=0; is<small.size(); is++){
+			ib=gallop(big, ib, small[is].index);
+			if(ib==big.size()) return true;
+			if(big[ib].index==small[is].index && (big[ib].bb & small[is].bb))
+							return false;	//bit in common
+		}
+		return true;
+	}
+
 	int i1=0, i2=0;
 	while(true){
 		//exit condition I
-		if(i1==m_aBB.size() || i2==rhs.m_aBB.size() ){		//size should be the same
+		if(i1==n1 || i2==n2 ){
 					return true;
 		}
 
@@ -306,7 +372,7 @@ return true;		//disjoint
 
 void BitBoardS::erase_bit(int nbit /*0 based*/){
 //////////////
-// clears bitblock information (does not remove bitblock if empty) 
+// clears bitblock information (does not remove bitblock if empty, unless in auto compaction mode) 
 // REMARKS: range must be sorted
 
 	int index=WDIV(nbit);
@@ -321,8 +387,10 @@ void BitBoardS::erase_bit(int nbit /*0 based*/){
 	velem_it it=lower_bound(m_aBB.begin(), m_aBB.end(), elem(index), elem_less());
 	if(it!=m_aBB.end()){
 		//check if the element exists already
-		if(it->index==index)
+		if(it->index==index){
 			it->bb&=~Tables::mask[WMOD(nbit)];
+			if(m_compact && !it->bb) m_aBB.erase(it);
+		}
 	}
 }
 
@@ -553,6 +621,7 @@ inline
 BitBoardS& AND (const BitBoardS& lhs, const BitBoardS& rhs,  BitBoardS& res){
 ///////////////////////////
 // AND between sparse sets
+// (the blocks of the smaller operand are searched by galloping when the sizes are skewed)
 //		
 	int i2=0;
 	res.erase_bit();					//experimental (and simplest solution)
@@ -560,6 +629,19 @@ BitBoardS& AND (const BitBoardS& lhs, const BitBoardS& rhs,  BitBoardS& res){
 
 	//empty check of rhs required, the way it is implemented
 	if(MAX==EMPTY_ELEM) return res;
+
+	if(BitBoardS::is_skewed(lhs.m_aBB.size(), rhs.m_aBB.size())){
+		const BitBoardS::velem& small=(lhs.m_aBB.size()<rhs.m_aBB.size())? lhs.m_aBB : rhs.m_aBB;
+		const BitBoardS::velem& big=(lhs.m_aBB.size()<rhs.m_aBB.size())? rhs.m_aBB : lhs.m_aBB;
+		int ib=0;
+		for(int is=0; is<small.size(); is++){
+			ib=BitBoardS::gallop(big, ib, small[is].index);
+			if(ib==big.size()) break;
+			if(big[ib].index==small[is].index)
+				res.m_aBB.push_back(BitBoardS::elem(small[is].index, small[is].bb & big[ib].bb));
+		}
+		return res;
+	}
 	
 	//optimization which works if lhs has less 1-bits than rhs
 	for (int i1 = 0; i1 < lhs.m_aBB.size();i1++){
@@ -736,6 +818,7 @@ BitBoardS&  BitBoardS::erase_block (int first_block, const BitBoardS& rhs ){
 		}
 
 	}
+	if(m_compact) compact();
 	
 return *this;
 }
@@ -755,11 +838,11 @@ BitBoardS&  BitBoardS::AND_EQ(int first_block, const BitBoardS& rhs ){
 	while( true ){
 		//exit condition 
 		if(p1.second==m_aBB.end() ){		//size should be the same
-					return *this;
+					break;
 		}else if( p2.second==rhs.m_aBB.end()){  //fill with zeros from last block in rhs onwards
 			for(; p1.second!=m_aBB.end(); ++p1.second)
 				p1.second->bb=ZERO;
-			return *this;
+			break;
 		}
 
 		//update before either of the bitstrings has reached its end
@@ -774,6 +857,7 @@ BitBoardS&  BitBoardS::AND_EQ(int first_block, const BitBoardS& rhs ){
 		}
 
 	}
+	if(m_compact) compact();
 	
 return *this;
 }
@@ -825,6 +909,7 @@ BitBoardS&  BitBoardS::erase_block_pos (int first_pos_of_block, const BitBoardS&
 				m_aBB[i1].bb&=~rhs.m_aBB[i2].bb;
 		}
 	}
+	if(m_compact) compact();
 
 return *this;
 }
@@ -857,6 +942,7 @@ BitBoardS&  BitBoardS::erase_block (int first_block, int last_block, const BitBo
 			break;
 		}
 	}while(true);
+	if(m_compact) compact();
 	
 return *this;
 }
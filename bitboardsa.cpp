@@ -0,0 +1,335 @@
+// bitboardsa.cpp: implementation of the BitBoardSA class, sparse bit strings with a structure of arrays layout
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "bitboardsa.h"
+#include <iostream>
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+BitBoardSA::BitBoardSA(int size /*1 based*/, bool is_popsize){
+	(is_popsize)? m_MAXBB=INDEX_1TO1(size) : m_MAXBB=size;
+}
+
+int BitBoardSA::init(int size, bool is_popsize){
+	clear();
+	(is_popsize)? m_MAXBB=INDEX_1TO1(size) : m_MAXBB=size;
+return 0;
+}
+
+void BitBoardSA::clear(){
+	m_index.clear();
+	m_bb.clear();
+	m_MAXBB=EMPTY_ELEM;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Setters and getters
+//////////////////////////////////////////////////////////////////////
+
+BITBOARD BitBoardSA::find_bitboard(int block_index) const{
+	int pos=lower_pos(block_index);
+	if(pos<m_index.size() && m_index[pos]==block_index)
+		return m_bb[pos];
+return EMPTY_ELEM;
+}
+
+pair<bool, int> BitBoardSA::find_pos(int block_index) const{
+////////////////
+// returns first:true if block exists second:lower bound index in the collection or EMPTY_ELEM if no block exists above the index
+
+	pair<bool, int> res(false, EMPTY_ELEM);
+	int pos=lower_pos(block_index);
+	if(pos<m_index.size()){
+		res.second=pos;
+		res.first=(m_index[pos]==block_index);
+	}
+return res;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Conversion to and from BitBoardS
+//////////////////////////////////////////////////////////////////////
+
+int BitBoardSA::from_sparse(const BitBoardS& bbs){
+	m_MAXBB=bbs.m_MAXBB;
+	m_index.resize(bbs.m_aBB.size());
+	m_bb.resize(bbs.m_aBB.size());
+	for(int i=0; i<bbs.m_aBB.size(); i++){
+		m_index[i]=bbs.m_aBB[i].index;
+		m_bb[i]=bbs.m_aBB[i].bb;
+	}
+return 0;
+}
+
+int BitBoardSA::to_sparse(BitBoardS& bbs) const{
+	bbs.init(m_MAXBB, false);
+	bbs.m_aBB.reserve(m_index.size());
+	for(int i=0; i<m_index.size(); i++)
+		bbs.m_aBB.push_back(BitBoardS::elem(m_index[i], m_bb[i]));
+return 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Bit updates
+//////////////////////////////////////////////////////////////////////
+
+int BitBoardSA::set_bit(int nbit){
+	int index=WDIV(nbit);
+	if(index>=m_MAXBB){
+		cerr<<"bit outside population limit: "<<nbit<<endl;
+		return -1;
+	}
+
+	int pos=lower_pos(index);
+	if(pos<m_index.size() && m_index[pos]==index){
+		m_bb[pos]|=Tables::mask[WMOD(nbit)];
+	}else{											//new block (at the end if pos==size)
+		m_index.insert(m_index.begin()+pos, (U32)index);
+		m_bb.insert(m_bb.begin()+pos, Tables::mask[WMOD(nbit)]);
+	}
+return 0;
+}
+
+void BitBoardSA::erase_bit(int nbit){
+	int index=WDIV(nbit);
+	int pos=lower_pos(index);
+	if(pos<m_index.size() && m_index[pos]==index)
+		m_bb[pos]&=~Tables::mask[WMOD(nbit)];
+}
+
+void BitBoardSA::shrink_to_fit(){
+	int n=0;
+	for(int i=0; i<m_bb.size(); i++){
+		if(m_bb[i]){
+			m_index[n]=m_index[i];
+			m_bb[n++]=m_bb[i];
+		}
+	}
+	m_index.resize(n);
+	m_bb.resize(n);
+	m_index.shrink_to_fit();
+	m_bb.shrink_to_fit();
+}
+
+//////////////////////////////////////////////////////////////////////
+// Operators
+//////////////////////////////////////////////////////////////////////
+
+BitBoardSA& BitBoardSA::operator &=(const BitBoardSA& rhs){
+///////////////////
+// AND in place: the common blocks are compacted to the front
+
+	int i1=0, i2=0, n=0;
+	const int n1=m_index.size(), n2=rhs.m_index.size();
+	while(i1<n1 && i2<n2){
+		if(m_index[i1]<rhs.m_index[i2]){
+			i1++;
+		}else if(rhs.m_index[i2]<m_index[i1]){
+			i2++;
+		}else{
+			BITBOARD bb=m_bb[i1] & rhs.m_bb[i2];
+			if(bb){
+				m_index[n]=m_index[i1];
+				m_bb[n++]=bb;
+			}
+			i1++, i2++;
+		}
+	}
+	m_index.resize(n);
+	m_bb.resize(n);
+return *this;
+}
+
+BitBoardSA& BitBoardSA::operator |=(const BitBoardSA& rhs){
+	BitBoardSA res;
+	OR(*this, rhs, res);
+	m_index.swap(res.m_index);
+	m_bb.swap(res.m_bb);
+return *this;
+}
+
+BitBoardSA& AND(const BitBoardSA& lhs, const BitBoardSA& rhs, BitBoardSA& res){
+///////////////////
+// AND between sparse sets (empty blocks are not stored)
+
+	res.erase_bit();
+	int i1=0, i2=0;
+	const int n1=lhs.m_index.size(), n2=rhs.m_index.size();
+	while(i1<n1 && i2<n2){
+		if(lhs.m_index[i1]<rhs.m_index[i2]){
+			i1++;
+		}else if(rhs.m_index[i2]<lhs.m_index[i1]){
+			i2++;
+		}else{
+			BITBOARD bb=lhs.m_bb[i1] & rhs.m_bb[i2];
+			if(bb){
+				res.m_index.push_back(lhs.m_index[i1]);
+				res.m_bb.push_back(bb);
+			}
+			i1++, i2++;
+		}
+	}
+return res;
+}
+
+BitBoardSA& OR(const BitBoardSA& lhs, const BitBoardSA& rhs, BitBoardSA& res){
+	res.erase_bit();
+	res.m_index.reserve(lhs.m_index.size()+rhs.m_index.size());
+	res.m_bb.reserve(lhs.m_index.size()+rhs.m_index.size());
+
+	int i1=0, i2=0;
+	const int n1=lhs.m_index.size(), n2=rhs.m_index.size();
+	while(i1<n1 && i2<n2){
+		if(lhs.m_index[i1]<rhs.m_index[i2]){
+			res.m_index.push_back(lhs.m_index[i1]);
+			res.m_bb.push_back(lhs.m_bb[i1++]);
+		}else if(rhs.m_index[i2]<lhs.m_index[i1]){
+			res.m_index.push_back(rhs.m_index[i2]);
+			res.m_bb.push_back(rhs.m_bb[i2++]);
+		}else{
+			res.m_index.push_back(lhs.m_index[i1]);
+			res.m_bb.push_back(lhs.m_bb[i1++] | rhs.m_bb[i2++]);
+		}
+	}
+
+	//remaining blocks
+	res.m_index.insert(res.m_index.end(), lhs.m_index.begin()+i1, lhs.m_index.end());
+	res.m_bb.insert(res.m_bb.end(), lhs.m_bb.begin()+i1, lhs.m_bb.end());
+	res.m_index.insert(res.m_index.end(), rhs.m_index.begin()+i2, rhs.m_index.end());
+	res.m_bb.insert(res.m_bb.end(), rhs.m_bb.begin()+i2, rhs.m_bb.end());
+return res;
+}
+
+BitBoardSA& ERASE(const BitBoardSA& lhs, const BitBoardSA& rhs, BitBoardSA& res){
+	res.erase_bit();
+	int i2=0;
+	const int n2=rhs.m_index.size();
+	for(int i1=0; i1<lhs.m_index.size(); i1++){
+		for(; i2<n2 && rhs.m_index[i2]<lhs.m_index[i1]; i2++){}
+		BITBOARD bb=lhs.m_bb[i1];
+		if(i2<n2 && rhs.m_index[i2]==lhs.m_index[i1])
+			bb&=~rhs.m_bb[i2];
+		if(bb){
+			res.m_index.push_back(lhs.m_index[i1]);
+			res.m_bb.push_back(bb);
+		}
+	}
+return res;
+}
+
+bool operator ==(const BitBoardSA& lhs, const BitBoardSA& rhs){
+////////////////////
+// same 1-bits (empty blocks are ignored)
+
+	int i1=0, i2=0;
+	const int n1=lhs.m_index.size(), n2=rhs.m_index.size();
+	while(true){
+		while(i1<n1 && !lhs.m_bb[i1]) i1++;
+		while(i2<n2 && !rhs.m_bb[i2]) i2++;
+		if(i1==n1 || i2==n2) return (i1==n1 && i2==n2);
+		if(lhs.m_index[i1]!=rhs.m_index[i2] || lhs.m_bb[i1]!=rhs.m_bb[i2]) return false;
+		i1++, i2++;
+	}
+return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Boolean functions
+//////////////////////////////////////////////////////////////////////
+
+bool BitBoardSA::is_empty() const{
+	for(int i=0; i<m_bb.size(); i++)
+		if(m_bb[i]) return false;
+return true;
+}
+
+bool BitBoardSA::is_disjoint(const BitBoardSA& rhs) const{
+	int i1=0, i2=0;
+	const int n1=m_index.size(), n2=rhs.m_index.size();
+	while(i1<n1 && i2<n2){
+		if(m_index[i1]<rhs.m_index[i2]){
+			i1++;
+		}else if(rhs.m_index[i2]<m_index[i1]){
+			i2++;
+		}else{
+			if(m_bb[i1] & rhs.m_bb[i2]) return false;
+			i1++, i2++;
+		}
+	}
+return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Bit scanning
+//////////////////////////////////////////////////////////////////////
+
+int BitBoardSA::init_scan(scan_cursor& sc, scan_types sct) const{
+	if(m_index.empty()) return EMPTY_ELEM;				//sparse bitstrings have empty semantics
+
+	switch(sct){
+	case NON_DESTRUCTIVE:
+		sc.bbi=0;
+		sc.pos=MASK_LIM;
+		break;
+	case NON_DESTRUCTIVE_REVERSE:
+		sc.bbi=m_index.size()-1;
+		sc.pos=WORD_SIZE;
+		break;
+	case DESTRUCTIVE:
+		sc.bbi=0;
+		break;
+	case DESTRUCTIVE_REVERSE:
+		sc.bbi=m_index.size()-1;
+		break;
+	default:
+		cerr<<"bad scan type"<<endl;
+		return -1;
+	}
+return 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// I/O
+//////////////////////////////////////////////////////////////////////
+
+void BitBoardSA::print(ostream& o, bool show_pc) const{
+/////////////////////////
+// shows bit string as [bit1 bit2 bit3 ... <(pc)>]  (if empty: [ ]) (<pc> optional)
+
+	o<<"[";
+	scan_cursor sc;
+	if(init_scan(sc, NON_DESTRUCTIVE)!=EMPTY_ELEM){
+		for(int nBit=next_bit(sc); nBit!=EMPTY_ELEM; nBit=next_bit(sc))
+			o<<nBit<<" ";
+	}
+
+	if(show_pc){
+		int pc=popcn64();
+		if(pc) o<<"("<<pc<<")";
+	}
+	o<<"]";
+}
+
+void BitBoardSA::to_vector(std::vector<int>& vl) const{
+	int pc=popcn64();
+	vl.resize(pc);
+	if(pc) decode(&vl[0], pc);
+}
+
+int BitBoardSA::decode(int* out, int max) const{
+//////////////////////
+// writes the 1-bits in increasing order in one pass (see BBKernel::bb_decode)
+//
+// RETURNS the number of 1-bits written (at most max)
+
+	int n=0;
+	for(int i=0; i<m_bb.size() && n<max; i++){
+		n+=BBKernel::bb_decode(&m_bb[i], 1, WMUL(m_index[i]), out+n, max-n);
+	}
+return n;
+}
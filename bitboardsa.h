@@ -0,0 +1,241 @@
+/*
+ * bitboardsa.h file from the BITSCAN library, a C++ library for bit set
+ * optimization. BITSCAN has been used to implement BBMC, a very
+ * succesful bit-parallel algorithm for exact maximum clique.
+ * (see license file for references)
+ *
+ * Copyright (C)
+ * Author: Pablo San Segundo
+ * Intelligent Control Research Group (CSIC-UPM)
+ *
+ * Permission to use, modify and distribute this software is
+ * granted provided that this copyright notice appears in all
+ * copies, in source code or in binaries. For precise terms
+ * see the accompanying LICENSE file.
+ *
+ * This software is provided "AS IS" with no warranty of any
+ * kind, express or implied, and with no claim as to its
+ * suitability for any purpose.
+ *
+ */
+
+#ifndef __BITBOARDSA_H__
+#define __BITBOARDSA_H__
+
+#include "bbobject.h"
+#include "bitboard.h"
+#include "bitboards.h"
+#include "bbkernel.h"
+#include <vector>
+
+using namespace std;
+
+/////////////////////////////////
+//
+// class BitBoardSA
+// (Manages sparse bit strings, structure of arrays layout)
+//
+// Same model as BitBoardS (sorted non-empty bitblocks) but the block indexes (32 bits) and
+// the bitblocks are kept in two separate contiguous arrays. Searches only touch the
+// indexes (16 per cache line instead of 4 elem_t), so binary searches, merges and bit
+// scans stream through half the memory, and the bitblocks can be passed directly to
+// the bulk kernels (BBKernel)
+//
+///////////////////////////////////
+
+class BitBoardSA: public BBObject{
+public:
+	static const int LINEAR_SEARCH=16;								//binary searches end with a (vectorizable) linear count over this many indexes
+
+	typedef vector<U32> vindex;
+	typedef vector<BITBOARD> vbb;
+	typedef scan_cursor scan_t;										//bbi: position in the collection
+
+	friend bool operator ==			(const BitBoardSA&, const BitBoardSA&);
+	friend bool operator !=			(const BitBoardSA& lhs, const BitBoardSA& rhs)	{return !(lhs==rhs);}
+
+	friend BitBoardSA&  AND			(const BitBoardSA& lhs, const BitBoardSA& rhs,  BitBoardSA& res);
+	friend BitBoardSA&  OR			(const BitBoardSA& lhs, const BitBoardSA& rhs,  BitBoardSA& res);
+	friend BitBoardSA&  ERASE		(const BitBoardSA& lhs, const BitBoardSA& rhs,  BitBoardSA& res);	//removes rhs from lhs
+
+	BitBoardSA						():m_MAXBB(EMPTY_ELEM){}
+explicit BitBoardSA					(int size, bool is_popsize=true);								//popsize is 1-based
+explicit BitBoardSA					(const BitBoardS& bbs)	{from_sparse(bbs);}
+virtual ~BitBoardSA					(){}
+
+	int init						(int size, bool is_popsize=true);
+	void clear						();
+
+/////////////////////
+// setters and getters
+	int number_of_bitblocks			()						const {return m_index.size();}
+	int get_index					(int pos)				const {return m_index[pos];}		//position in the collection
+	BITBOARD get_bitboard			(int pos)				const {return m_bb[pos];}
+	const BITBOARD* get_bitstring	()						const {return m_bb.data();}
+	BITBOARD find_bitboard			(int block_index)		const;							//EMPTY_ELEM if the block does not exist
+	pair<bool, int> find_pos		(int block_index)		const;							//(block exists, lower bound position or EMPTY_ELEM)
+inline	int lower_pos				(int block_index, int from=0)	const;					//first position in [from, size[ with index>=block_index
+
+/////////////////////
+// conversion to and from BitBoardS
+	int from_sparse					(const BitBoardS& );
+	int to_sparse					(BitBoardS& )			const;
+
+/////////////////////
+// Set/Delete Bits (nbit is always 0 based)
+	int set_bit						(int nbit);												//ordered insertion by bit block index
+	void erase_bit					(int nbit);												//does not remove the bitblock if empty
+	void erase_bit					()						{m_index.clear(); m_bb.clear();}
+	void shrink_to_fit				();														//removes empty bitblocks and frees memory
+
+////////////////////////
+// Operators
+	BitBoardSA& operator &=			(const BitBoardSA& );									//empty bitblocks are removed
+	BitBoardSA& operator |=			(const BitBoardSA& );
+
+/////////////////////////////
+// Boolean functions
+inline	bool is_bit					(int nbit)				const;
+	bool is_empty					()						const;
+	bool is_disjoint				(const BitBoardSA& )	const;
+
+/////////////////
+// Popcount
+	int popcn64						()						const	{return BBKernel::bb_popc(m_bb.data(), m_bb.size());}
+
+//////////////////////////////
+// Bitscanning (same interface as BBIntrinS)
+	int init_scan					(scan_types sct)		{return init_scan(m_scan, sct);}
+inline	int next_bit				()						{return next_bit(m_scan);}
+inline	int next_bit_del			()						{return next_bit_del(m_scan);}
+inline	int previous_bit			()						{return previous_bit(m_scan);}
+inline	int previous_bit_del		()						{return previous_bit_del(m_scan);}
+
+	int init_scan					(scan_cursor&, scan_types)		const;
+inline	int next_bit				(scan_cursor&)					const;
+inline	int previous_bit			(scan_cursor&)					const;
+inline	int next_bit_del			(scan_cursor&);
+inline	int previous_bit_del		(scan_cursor&);
+
+/////////////////////
+// I/O
+virtual	void print					(ostream& = cout, bool show_pc = true) const;
+	void to_vector					(std::vector<int>& )	const;
+	int decode						(int* out, int max)		const;			//1-bits to out (at most max), returns the number written
+
+////////////////////////
+// Member data
+public:
+	scan_t m_scan;
+protected:
+	vindex m_index;					//sorted block indexes
+	vbb m_bb;						//bitblocks (m_bb[i] is the block m_index[i])
+	int m_MAXBB;					//maximum possible number of bitblocks
+};
+
+///////////////////////
+//
+// INLINE FUNCTIONS
+//
+////////////////////////
+
+inline int BitBoardSA::lower_pos(int block_index, int from) const{
+///////////////////
+// binary search which ends with a branchless count when the range fits in a cache line
+
+	const U32* idx=m_index.data();
+	const U32 key=block_index;
+	int lo=from, n=m_index.size()-from;
+	while(n>LINEAR_SEARCH){
+		int half=n/2;
+		if(idx[lo+half]<key){
+			lo+=half+1;
+			n-=half+1;
+		}else
+			n=half;
+	}
+
+	int count=0;
+	for(int i=0; i<n; i++)
+		count+=(idx[lo+i]<key);
+return lo+count;
+}
+
+inline bool BitBoardSA::is_bit(int nbit) const{
+	int pos=lower_pos(WDIV(nbit));
+	if(pos<m_index.size() && m_index[pos]==WDIV(nbit))
+		return (m_bb[pos] & Tables::mask[WMOD(nbit)]);
+return false;
+}
+
+inline int BitBoardSA::next_bit(scan_cursor& sc) const{
+////////////////////////////
+// non destructive: requires sc.bbi=0 and sc.pos=MASK_LIM
+
+	unsigned long posbb;
+	if(_BitScanForward64(&posbb, m_bb[sc.bbi] & Tables::mask_left[sc.pos])){
+		sc.pos=posbb;
+		return (posbb + WMUL(m_index[sc.bbi]));
+	}else{
+		for(int i=sc.bbi+1; i<m_bb.size(); i++){
+			if(_BitScanForward64(&posbb, m_bb[i])){
+				sc.bbi=i;
+				sc.pos=posbb;
+				return (posbb + WMUL(m_index[i]));
+			}
+		}
+	}
+return EMPTY_ELEM;
+}
+
+inline int BitBoardSA::previous_bit(scan_cursor& sc) const{
+////////////////////////////
+// non destructive: requires sc.bbi=number of bitblocks-1 and sc.pos=WORD_SIZE
+
+	unsigned long posbb;
+	if(_BitScanReverse64(&posbb, m_bb[sc.bbi] & Tables::mask_right[sc.pos])){
+		sc.pos=posbb;
+		return (posbb + WMUL(m_index[sc.bbi]));
+	}else{
+		for(int i=sc.bbi-1; i>=0; i--){
+			if(_BitScanReverse64(&posbb, m_bb[i])){
+				sc.bbi=i;
+				sc.pos=posbb;
+				return (posbb + WMUL(m_index[i]));
+			}
+		}
+	}
+return EMPTY_ELEM;
+}
+
+inline int BitBoardSA::next_bit_del(scan_cursor& sc){
+////////////////////////////
+// destructive: requires sc.bbi=0
+
+	unsigned long posbb;
+	for(int i=sc.bbi; i<m_bb.size(); i++){
+		if(_BitScanForward64(&posbb, m_bb[i])){
+			sc.bbi=i;
+			m_bb[i]&=~Tables::mask[posbb];			//deleting before the return
+			return (posbb + WMUL(m_index[i]));
+		}
+	}
+return EMPTY_ELEM;
+}
+
+inline int BitBoardSA::previous_bit_del(scan_cursor& sc){
+////////////////////////////
+// destructive: requires sc.bbi=number of bitblocks-1
+
+	unsigned long posbb;
+	for(int i=sc.bbi; i>=0; i--){
+		if(_BitScanReverse64(&posbb, m_bb[i])){
+			sc.bbi=i;
+			m_bb[i]&=~Tables::mask[posbb];			//deleting before the return
+			return (posbb + WMUL(m_index[i]));
+		}
+	}
+return EMPTY_ELEM;
+}
+
+#endif
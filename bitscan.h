@@ -22,6 +22,15 @@
 #include "bbalg.h"
 #include "bbsentinel.h"			
 #include "bbintrinsic_sparse.h"	
+#include "bbstatic.h"
+#include "bbhybrid.h"
+#include "bitboardsa.h"
+#include "bbsummary.h"
+#include "bbrank.h"
+#include "bbfile.h"
+#include "bbmatrix.h"
+#include "bbparallel.h"
+#include "bbmc.h"
 
 //client data types
 typedef BitBoard bitblock;
@@ -30,5 +39,10 @@ typedef BBSentinel watched_bitarray;
 typedef BBIntrinS sparse_bitarray;
 typedef BitBoardN simple_bitarray;
 typedef BitBoardS simple_sparse_bitarray;
+typedef BitBoardH hybrid_bitarray;
+typedef BitBoardSA soa_sparse_bitarray;
+typedef BBSummary summary_bitarray;
+typedef BBRankSelect rank_select;
 typedef BBObject  bbo;
+template<int NBITS> using static_bitarray = StaticBitBoard<NBITS>;
 
@@ -37,9 +37,24 @@
 #endif
 
 ////////////////////
-//Use of C memory allocation alignment primitives instead of C++ new statement				
-#define _MEM_ALIGNMENT 				32						//change this for different allignments (now deprecated in favor of 64 bits)
-#undef  _MEM_ALIGNMENT										//DEFAULT
+//vectorized kernels for bulk set operations (see bbkernel.h)
+#define SIMD_KERNELS									//selects SSE2/AVX2/AVX-512 kernels at startup with CPUID (DEFAULT)
+//#undef  SIMD_KERNELS									//scalar loops only
+
+#define SIMD_AVX512										//AVX-512 kernels may be selected (DEFAULT)
+//#undef  SIMD_AVX512									//caps the selection at AVX2 (i.e. CPUs which throttle frequency on AVX-512)
+
+////////////////////
+//multithreaded bulk operations (see bbparallel.h)
+#define PARALLEL_MIN_BLOCKS			(1<<16)					//bit strings with fewer bitblocks (4M bits) are processed serially
+#define PARALLEL_GRAIN				(1<<12)					//minimum number of bitblocks of a task (32KB)
+#define PARALLEL_THREADS			0						//threads of the default pool (0: hardware concurrency)
+#define PARALLEL_TASKS				8						//popcount balanced ranges per thread in parallel enumerations
+
+////////////////////
+//Memory allocation of bitblocks (see bballoc.h)
+#define _MEM_ALIGNMENT 				64						//alignment (bytes) of the default allocator: one cache line (DEFAULT)
+#define HUGE_PAGE_SIZE				(2*1024*1024)			//huge page size (bytes) for BBHugePageAlloc
  
 //////////////////////
 // precomputed tables
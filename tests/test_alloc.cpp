@@ -0,0 +1,109 @@
+//tests for the allocation policies of dense bit strings
+
+#include <iostream>
+
+#include "../bitscan.h"				//bit string library
+#include "google/gtest/gtest.h"
+
+using namespace std;
+
+//counts allocations to check that deallocation matches
+class CountingAlloc: public BBAlignedAlloc{
+public:
+	CountingAlloc():nalloc(0), nfree(0){}
+	BITBOARD* allocate(size_t nBB)					{nalloc++; return BBAlignedAlloc::allocate(nBB);}
+	void deallocate(BITBOARD* p, size_t nBB)		{nfree++; BBAlignedAlloc::deallocate(p, nBB);}
+	int nalloc, nfree;
+};
+
+TEST(Alloc, default_alignment){
+	for(int popsize=1; popsize<3000; popsize+=97){
+		BitBoardN bbn(popsize);
+		EXPECT_EQ(0, (size_t)bbn.get_bitstring() % _MEM_ALIGNMENT);
+	}
+
+	BBSentinel bbs(1000);
+	bbs.init(5000);
+	EXPECT_EQ(0, (size_t)bbs.get_bitstring() % _MEM_ALIGNMENT);
+	EXPECT_EQ(BBAlloc::get_default(), bbs.get_allocator());
+}
+
+TEST(Alloc, custom_allocator){
+	CountingAlloc alloc;
+	{
+		BBIntrin bbi(1000, alloc);
+		bbi.set_bit(999);
+		bbi.init(2000);
+		EXPECT_EQ(2, alloc.nalloc);
+		EXPECT_EQ(1, alloc.nfree);
+		EXPECT_FALSE(bbi.is_bit(999));
+		
+		BBIntrin copy(bbi);							//copies use the default allocator 
+		EXPECT_EQ(2, alloc.nalloc);
+	}
+	EXPECT_EQ(alloc.nalloc, alloc.nfree);
+}
+
+TEST(Alloc, huge_pages){
+	BBHugePageAlloc alloc(64*1024);					//huge pages from 64K onwards
+	BitBoardN small(1000, alloc);
+	BitBoardN huge(10000000, alloc);
+	EXPECT_EQ(0, (size_t)small.get_bitstring() % _MEM_ALIGNMENT);
+	EXPECT_EQ(0, (size_t)huge.get_bitstring() % HUGE_PAGE_SIZE);
+	
+	huge.set_bit(9999999);
+	EXPECT_EQ(1, huge.popcn64());
+}
+
+TEST(Alloc, arena){
+	const int POP=1000, DEPTH=10;
+	BBArena arena(BBArena::bytes_for(POP, DEPTH));
+	EXPECT_EQ(0, arena.used());
+
+	//one bit string per depth, carved contiguously
+	vector<BBIntrin*> stack;
+	for(int d=0; d<DEPTH; d++){
+		stack.push_back(new BBIntrin(POP, arena));
+		EXPECT_TRUE(arena.owns(stack.back()->get_bitstring()));
+		EXPECT_EQ(0, (size_t)stack.back()->get_bitstring() % _MEM_ALIGNMENT);
+		stack.back()->set_bit(d);
+	}
+	EXPECT_EQ(arena.capacity(), arena.used());
+	EXPECT_EQ(0, arena.number_of_fallbacks());
+	for(int d=0; d<DEPTH; d++){
+		EXPECT_EQ(1, stack[d]->popcn64());
+		EXPECT_TRUE(stack[d]->is_bit(d));
+	}
+
+	//full: falls back to the aligned allocator
+	BBIntrin* extra=new BBIntrin(POP, arena);
+	EXPECT_FALSE(arena.owns(extra->get_bitstring()));
+	EXPECT_EQ(1, arena.number_of_fallbacks());
+	delete extra;
+
+	for(int d=0; d<DEPTH; d++) delete stack[d];
+	EXPECT_EQ(arena.capacity(), arena.used());			//only released explicitly
+	arena.reset();
+	EXPECT_EQ(0, arena.used());
+}
+
+TEST(Alloc, arena_backtrack){
+	const int POP=200;
+	BBArena arena(BBArena::bytes_for(POP, 8));
+	BBSentinel root(POP, arena);
+	BBArena::mark_t m=arena.mark();
+	{
+		BBArena::scope frame(arena);
+		BBSentinel child(POP, arena);
+		BBSentinel grandchild(POP, arena);
+		grandchild.set_bit(10);
+		EXPECT_EQ(m+BBArena::bytes_for(POP, 2), arena.used());
+	}
+	EXPECT_EQ(m, arena.used());								//O(1) backtrack
+
+	//storage is reused by the next branch
+	BBSentinel sibling(POP, arena);
+	EXPECT_EQ(m, (size_t)((char*)sibling.get_bitstring()-(char*)root.get_bitstring()));
+	arena.release(m);
+	EXPECT_EQ(m, arena.used());
+}
@@ -0,0 +1,123 @@
+//tests for the BBMC maximum clique engine
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+
+#include "../bitscan.h"				//bit string library
+#include "google/gtest/gtest.h"
+
+using namespace std;
+
+static void random_graph(BitMatrix& g, int n, double p, unsigned seed){
+	srand(seed);
+	g.init(n, n);
+	for(int i=0; i<n; i++)
+		for(int j=i+1; j<n; j++)
+			if(rand()<p*RAND_MAX) g.set_symmetric(i, j);
+}
+
+static int brute_force(const BitMatrix& g, vector<int>& clique, int from){
+////////////////
+// size of a maximum clique which extends clique with vertices >= from
+
+	int best=clique.size();
+	for(int v=from; v<g.number_of_rows(); v++){
+		bool ok=true;
+		for(int i=0; i<clique.size() && ok; i++)
+			ok=g.is_bit(clique[i], v);
+		if(!ok) continue;
+		clique.push_back(v);
+		best=max(best, brute_force(g, clique, v+1));
+		clique.pop_back();
+	}
+return best;
+}
+
+TEST(BBMC, read_dimacs){
+	//K4 {1,2,3,4} plus the path 4-5-6
+	stringstream ss("c example\np edge 6 8\ne 1 2\ne 1 3\ne 1 4\ne 2 3\ne 2 4\ne 3 4\ne 4 5\ne 5 6\n");
+	BitMatrix g;
+	ASSERT_EQ(0, BBMC::read_dimacs(ss, g));
+	EXPECT_EQ(6, g.number_of_rows());
+	EXPECT_TRUE(g.is_bit(0, 3));
+	EXPECT_TRUE(g.is_bit(3, 0));
+	EXPECT_TRUE(g.is_bit(5, 4));
+	EXPECT_FALSE(g.is_bit(0, 5));
+	EXPECT_FALSE(g.is_bit(0, 0));
+
+	BBMC mc;
+	ASSERT_EQ(0, mc.init(g));
+	EXPECT_EQ(3, mc.width());
+	EXPECT_EQ(4, mc.search());
+	vector<int> sol={0, 1, 2, 3};
+	EXPECT_EQ(sol, mc.clique());
+
+	//ill-formed files
+	stringstream s1("e 1 2\np edge 2 1\n"), s2("p edge 3 1\ne 1 4\n"), s3("c no problem line\n");
+	EXPECT_EQ(-1, BBMC::read_dimacs(s1, g));
+	EXPECT_EQ(-1, BBMC::read_dimacs(s2, g));
+	EXPECT_EQ(-1, BBMC::read_dimacs(s3, g));
+	EXPECT_EQ(-1, BBMC::read_dimacs("no_such_file.clq", g));
+}
+
+TEST(BBMC, degeneracy_ordering){
+	//cycle of 10 vertices
+	BitMatrix g(10, 10);
+	for(int i=0; i<10; i++) g.set_symmetric(i, (i+1)%10);
+	vector<int> order;
+	EXPECT_EQ(2, BBMC::degeneracy_ordering(g, order));
+	ASSERT_EQ(10, order.size());
+	vector<int> sorted(order);
+	sort(sorted.begin(), sorted.end());
+	for(int i=0; i<10; i++) EXPECT_EQ(i, sorted[i]);
+
+	//complete graph
+	BitMatrix k(70, 70);
+	for(int i=0; i<70; i++)
+		for(int j=i+1; j<70; j++) k.set_symmetric(i, j);
+	EXPECT_EQ(69, BBMC::degeneracy_ordering(k, order));
+
+	BBMC mc;
+	mc.init(k);
+	EXPECT_EQ(70, mc.search());
+}
+
+TEST(BBMC, random_graphs){
+	const int n[]={30, 30, 30, 30, 70, 70, 70};					//the brute force search is exponential in the number of cliques
+	const double p[]={0.1, 0.3, 0.6, 0.9, 0.1, 0.3, 0.5};
+	BBMC mc;
+	for(int t=0; t<7; t++){
+		BitMatrix g;
+		random_graph(g, n[t], p[t], t+1);
+		vector<int> clique;
+		int omega=brute_force(g, clique, 0);
+
+		ASSERT_EQ(0, mc.init(g));
+		for(int sct=0; sct<2; sct++){
+			ASSERT_EQ(0, mc.set_scan(sct? BBObject::NON_DESTRUCTIVE : BBObject::DESTRUCTIVE));
+			EXPECT_EQ(omega, mc.search());
+			EXPECT_EQ(omega, mc.clique().size());
+			EXPECT_TRUE(BBMC::is_clique(g, mc.clique()));
+			EXPECT_LT(0, mc.number_of_steps());
+		}
+	}
+	EXPECT_EQ(-1, mc.set_scan(BBObject::DESTRUCTIVE_REVERSE));
+}
+
+TEST(BBMC, limit_cases){
+	BBMC mc;
+	BitMatrix empty;
+	ASSERT_EQ(0, mc.init(empty));
+	EXPECT_EQ(0, mc.search());
+	EXPECT_TRUE(mc.clique().empty());
+
+	BitMatrix isolated(100, 100);								//no edges
+	ASSERT_EQ(0, mc.init(isolated));
+	EXPECT_EQ(1, mc.search());
+	EXPECT_EQ(1, mc.clique().size());
+
+	BitMatrix rect(10, 20);
+	EXPECT_EQ(-1, mc.init(rect));
+}
@@ -2,6 +2,7 @@
 #include <iterator>
 #include <iostream>
 #include <set>
+#include <thread>
 
 #include "../bitscan.h"				//bit string library
 #include "google/gtest/gtest.h"
@@ -613,3 +614,228 @@ TEST(Bitstrings, single_disjoint){
 }
 
 
+
+TEST(Bitstrings, move_semantics){
+	BBIntrin bbi(300);
+	bbi.set_bit(10); bbi.set_bit(299);
+	const BITBOARD* p=bbi.get_bitstring();
+
+	BBIntrin moved(std::move(bbi));
+	EXPECT_EQ(p, moved.get_bitstring());					//no copy
+	EXPECT_TRUE(moved.is_bit(299));
+	EXPECT_EQ(NULL, bbi.get_bitstring());
+	EXPECT_EQ(EMPTY_ELEM, bbi.number_of_bitblocks());
+
+	BBIntrin other(1000);
+	other=std::move(moved);
+	EXPECT_EQ(p, other.get_bitstring());
+	EXPECT_EQ(2, other.popcn64());
+
+	//sentinels are moved along with the bit string
+	BBSentinel bbs(500);
+	bbs.set_bit(100); bbs.set_bit(200);
+	bbs.update_sentinels();
+	BBSentinel bbs1(std::move(bbs));
+	EXPECT_EQ(1, bbs1.get_sentinel_L());
+	EXPECT_EQ(3, bbs1.get_sentinel_H());
+	EXPECT_EQ(EMPTY_ELEM, bbs.get_sentinel_L());
+
+	//vectors of bit strings move on reallocation
+	vector<BBIntrin> vbb;
+	for(int i=0; i<100; i++){
+		vbb.push_back(BBIntrin(200));
+		vbb.back().set_bit(i);
+	}
+	for(int i=0; i<100; i++){
+		EXPECT_EQ(1, vbb[i].popcn64());
+		EXPECT_TRUE(vbb[i].is_bit(i));
+	}
+}
+
+TEST(Bitstrings, capacity){
+	BitBoardN bb(1000);
+	const BITBOARD* p=bb.get_bitstring();
+	EXPECT_EQ(INDEX_1TO1(1000), bb.capacity());
+
+	//init reuses storage when possible
+	bb.init(100);
+	EXPECT_EQ(p, bb.get_bitstring());
+	EXPECT_EQ(2, bb.number_of_bitblocks());
+	EXPECT_EQ(INDEX_1TO1(1000), bb.capacity());
+
+	//resize keeps the contents
+	bb.set_bit(5); bb.set_bit(99);
+	bb.resize(900);
+	EXPECT_EQ(p, bb.get_bitstring());
+	EXPECT_EQ(2, bb.popcn64());
+	EXPECT_FALSE(bb.is_bit(500));
+
+	bb.resize(50);											//bits beyond 49 are removed
+	EXPECT_EQ(1, bb.popcn64());
+	bb.resize(5000);
+	EXPECT_EQ(1, bb.popcn64());
+	EXPECT_TRUE(bb.is_bit(5));
+	EXPECT_LE(INDEX_1TO1(5000), bb.capacity());
+
+	bb.set_bit(127);
+	bb.resize(128);											//whole bitblocks: nothing to remove
+	EXPECT_EQ(2, bb.popcn64());
+	EXPECT_TRUE(bb.is_bit(127));
+	bb.resize(0);
+	EXPECT_EQ(0, bb.number_of_bitblocks());
+	EXPECT_TRUE(bb.is_empty());
+	bb.resize(200);
+	EXPECT_TRUE(bb.is_empty());
+
+	BitBoardN moved(1000);
+	BitBoardN taker(std::move(moved));
+	EXPECT_EQ(0, moved.resize(0));							//moved-from
+	EXPECT_EQ(0, moved.number_of_bitblocks());
+
+	//assignment between different sizes
+	BitBoardN bb1(130);
+	bb1.set_bit(129);
+	bb=bb1;
+	EXPECT_EQ(bb1.number_of_bitblocks(), bb.number_of_bitblocks());
+	EXPECT_TRUE(bb==bb1);
+}
+
+TEST_F(BitScanningTest, static_dispatch){
+	set<int> res;
+	int nBit=EMPTY_ELEM;
+
+	//non destructive
+	BBIntrinScan sc(bbi);
+	sc.init_scan(bbo::NON_DESTRUCTIVE);
+	while((nBit=sc.next_bit())!=EMPTY_ELEM)
+		res.insert(nBit);
+	EXPECT_EQ(sol, res);
+	EXPECT_EQ(bbi.popcn64(), sc.popcn64());
+	EXPECT_EQ(300, sc.msbn64());
+
+	//reverse destructive in the sentinel range
+	res.clear();
+	BBSentinelScan scs(bbs);
+	scs.init_scan(bbo::DESTRUCTIVE_REVERSE);
+	while((nBit=scs.previous_bit_del())!=EMPTY_ELEM)
+		res.insert(nBit);
+	EXPECT_EQ(sol, res);
+	EXPECT_TRUE(bbs.is_empty(0, bbs.number_of_bitblocks()-1));
+
+	//scan state is shared with the virtual interface
+	BBIntrin& ref=bbi;
+	sc.init_scan(bbo::NON_DESTRUCTIVE);
+	EXPECT_EQ(0, sc.next_bit());
+	EXPECT_EQ(50, ref.next_bit());
+	EXPECT_EQ(100, sc.next_bit());
+}
+
+TEST_F(BitScanningTest, range_for){
+	//forward and reverse, all dense types
+	vector<int> vsol(sol.begin(), sol.end());
+	vector<int> vrev(sol.rbegin(), sol.rend());
+	vector<int> res;
+	for(int v : bbn.bits()) res.push_back(v);
+	EXPECT_EQ(vsol, res);
+	res.clear();
+	for(int v : bbi.bits_reverse()) res.push_back(v);
+	EXPECT_EQ(vrev, res);
+	res.clear();
+	bbs.update_sentinels();
+	for(int v : bbs.bits()) res.push_back(v);
+	EXPECT_EQ(vsol, res);
+
+	//nested scans of a const bit string
+	const BBIntrin& cbb=bbi;
+	int npairs=0;
+	for(int v : cbb.bits())
+		for(int w : cbb.bits_reverse())
+			if(v<w) npairs++;
+	EXPECT_EQ(21, npairs);
+
+	//empty bit strings
+	BBIntrin empty(100);
+	EXPECT_TRUE(empty.bits().empty());
+	EXPECT_TRUE(empty.bits_reverse().empty());
+	BBSentinel empty_s(100);
+	empty_s.update_sentinels();
+	EXPECT_TRUE(empty_s.bits().empty());
+
+	//no storage (default constructed and moved-from)
+	BitBoardN none;
+	EXPECT_TRUE(none.bits().empty());
+	EXPECT_TRUE(none.bits_reverse().empty());
+	BitBoardN from(bbn);
+	BitBoardN to(std::move(from));
+	int n=0;
+	for(int v : from.bits()) n+=v;
+	for(int v : from.bits_reverse()) n+=v;
+	EXPECT_EQ(0, n);
+	EXPECT_FALSE(to.bits().empty());
+}
+
+TEST_F(BitScanningTest, external_cursor){
+	const BBIntrin& cbb=bbi;
+	vector<int> vsol(sol.begin(), sol.end());
+
+	//two interleaved scans of the same const bit string
+	bbo::scan_cursor c1, c2;
+	cbb.init_scan(c1, bbo::NON_DESTRUCTIVE);
+	cbb.init_scan(c2, bbo::NON_DESTRUCTIVE_REVERSE);
+	for(int i=0; i<vsol.size(); i++){
+		EXPECT_EQ(vsol[i], cbb.next_bit(c1));
+		EXPECT_EQ(vsol[vsol.size()-1-i], cbb.previous_bit(c2));
+	}
+	EXPECT_EQ(EMPTY_ELEM, cbb.next_bit(c1));
+	EXPECT_EQ(EMPTY_ELEM, cbb.previous_bit(c2));
+
+	cbb.init_scan_from(c1, 100, bbo::NON_DESTRUCTIVE);
+	EXPECT_EQ(150, cbb.next_bit(c1));
+
+	//sentinels
+	bbs.update_sentinels();
+	const BBSentinel& cbs=bbs;
+	cbs.init_scan(c1, bbo::NON_DESTRUCTIVE);
+	vector<int> res;
+	int nBit;
+	while((nBit=cbs.next_bit(c1))!=EMPTY_ELEM) res.push_back(nBit);
+	EXPECT_EQ(vsol, res);
+
+	//empty sentinels: the cursor is left at the end, bad scan types are errors
+	BBSentinel empty_s(1000);
+	empty_s.update_sentinels();
+	const BBSentinel& ces=empty_s;
+	EXPECT_EQ(0, ces.init_scan(c1, bbo::NON_DESTRUCTIVE));
+	EXPECT_EQ(EMPTY_ELEM, ces.next_bit(c1));
+	EXPECT_EQ(0, ces.init_scan(c2, bbo::NON_DESTRUCTIVE_REVERSE));
+	EXPECT_EQ(EMPTY_ELEM, ces.previous_bit(c2));
+	EXPECT_EQ(-1, ces.init_scan(c1, bbo::DESTRUCTIVE));
+	EXPECT_EQ(-1, cbs.init_scan(c1, bbo::DESTRUCTIVE_REVERSE));
+
+	//destructive scan with a cursor
+	res.clear();
+	bbi.init_scan(c1, bbo::DESTRUCTIVE);
+	while((nBit=bbi.next_bit_del(c1))!=EMPTY_ELEM) res.push_back(nBit);
+	EXPECT_EQ(vsol, res);
+	EXPECT_TRUE(bbi.is_empty());
+}
+
+TEST(Bitstrings, concurrent_scans){
+	BBIntrin bb(10000);
+	for(int i=0; i<10000; i+=3) bb.set_bit(i);
+	const BBIntrin& cbb=bb;
+
+	const int NTHREADS=4;
+	vector<int> count(NTHREADS, 0);
+	vector<thread> workers;
+	for(int t=0; t<NTHREADS; t++){
+		workers.push_back(thread([&cbb, &count, t](){
+			bbo::scan_cursor sc;
+			cbb.init_scan(sc, bbo::NON_DESTRUCTIVE);
+			while(cbb.next_bit(sc)!=EMPTY_ELEM) count[t]++;
+		}));
+	}
+	for(int t=0; t<NTHREADS; t++) workers[t].join();
+	for(int t=0; t<NTHREADS; t++)
+		EXPECT_EQ(bb.popcn64(), count[t]);
+}
@@ -0,0 +1,147 @@
+//tests for the binary file format and the memory mapped views (BBFileWriter, BBFileView)
+
+#include <iostream>
+#include <cstdio>
+#include <vector>
+
+#include "../bitscan.h"				//bit string library
+#include "google/gtest/gtest.h"
+
+using namespace std;
+
+TEST(File, dense_rows){
+	const char* filename="test_file_dense.bin";
+	const int N=1000, NROWS=50;
+	vector<BBIntrin> rows(NROWS, BBIntrin(N));
+	for(int i=0; i<NROWS; i++){
+		for(int j=i; j<N; j+=i+1)
+			rows[i].set_bit(j);
+	}
+
+	BBFileWriter w;
+	ASSERT_EQ(0, w.open(filename, N));
+	for(int i=0; i<NROWS; i++)
+		ASSERT_EQ(0, w.append(rows[i]));
+	EXPECT_EQ(-1, w.append(BBIntrin(2*N)));							//size mismatch
+	EXPECT_EQ(-1, w.append(BitBoardS(N)));							//not a sparse file
+	ASSERT_EQ(0, w.close());
+
+	BBFileView view(filename);
+	ASSERT_TRUE(view.is_open());
+	EXPECT_EQ(NROWS, view.number_of_rows());
+	EXPECT_EQ(N, view.popsize());
+	EXPECT_EQ(BB_FILE_VERSION, view.version());
+	EXPECT_EQ(BBFileFormat::DENSE, view.kind());
+
+	for(int i=0; i<NROWS; i++){
+		const BBIntrin& row=view.row(i);
+		EXPECT_TRUE(row==rows[i]);
+		EXPECT_EQ(0, (size_t)row.get_bitstring()%BB_FILE_ALIGN);		//in place, aligned
+	}
+
+	//const API on the mapped rows
+	const BBIntrin& r3=view.row(3);
+	BBIntrin::scan_t sc;
+	vector<int> v;
+	r3.init_scan(sc, bbo::NON_DESTRUCTIVE);
+	for(int nBit=r3.next_bit(sc); nBit!=EMPTY_ELEM; nBit=r3.next_bit(sc))
+		v.push_back(nBit);
+	EXPECT_EQ(r3.popcn64(), v.size());
+	EXPECT_EQ(3, v[0]);
+
+	BBIntrin res(N);
+	AND(view.row(1), view.row(2), res);
+	EXPECT_EQ(view.row(1).popcount_and(view.row(2)), res.popcn64());
+
+	BBIntrin copy(view.row(7));										//owns its bitblocks
+	copy.set_bit(0);
+	EXPECT_FALSE(view.row(7).is_bit(0));
+
+	view.close();
+	EXPECT_FALSE(view.is_open());
+
+	//misaligned directory (4 bytes inserted before an otherwise valid directory)
+	FILE* f=fopen(filename, "rb");
+	fseek(f, 0, SEEK_END);
+	vector<char> bytes(ftell(f));
+	fseek(f, 0, SEEK_SET);
+	ASSERT_EQ(1, fread(&bytes[0], bytes.size(), 1, f));
+	fclose(f);
+	BBFileFormat::header_t* h=(BBFileFormat::header_t*)&bytes[0];
+	bytes.insert(bytes.begin()+h->dir_offset, 4, 0);
+	h=(BBFileFormat::header_t*)&bytes[0];
+	h->dir_offset+=4;
+	f=fopen(filename, "wb");
+	fwrite(&bytes[0], bytes.size(), 1, f);
+	fclose(f);
+	EXPECT_EQ(-1, view.open(filename));
+	remove(filename);
+}
+
+TEST(File, sparse_rows){
+	const char* filename="test_file_sparse.bin";
+	const int N=200000;
+	vector<BitBoardS> rows(3, BitBoardS(N));
+	rows[0].set_bit(5); rows[0].set_bit(150000);
+	for(int i=0; i<N; i+=997) rows[2].set_bit(i);
+
+	BBFileWriter w;
+	ASSERT_EQ(0, w.open(filename, N, BBFileFormat::SPARSE));
+	for(int i=0; i<rows.size(); i++)
+		ASSERT_EQ(0, w.append(rows[i]));
+	ASSERT_EQ(0, w.close());
+
+	BBFileView view(filename);
+	ASSERT_TRUE(view.is_open());
+	EXPECT_EQ(BBFileFormat::SPARSE, view.kind());
+	for(int i=0; i<rows.size(); i++){
+		BitBoardS bbs;
+		ASSERT_EQ(0, view.load_row(i, bbs));
+		EXPECT_TRUE(bbs==rows[i]);
+		EXPECT_EQ(rows[i].popcn64(), bbs.popcn64());
+	}
+	BitBoardN bbn;
+	EXPECT_EQ(-1, view.load_row(0, bbn));							//not a dense file
+	view.close();
+
+	//corrupt indexes of the second pair of row 0 (stored right after the header)
+	const BITBOARD bad_index[2]={0, (BITBOARD)INDEX_1TO1(N)};		//not increasing, outside the population
+	for(int k=0; k<2; k++){
+		FILE* f=fopen(filename, "r+b");
+		fseek(f, sizeof(BBFileFormat::header_t)+2*sizeof(BITBOARD), SEEK_SET);
+		fwrite(&bad_index[k], sizeof(BITBOARD), 1, f);
+		fclose(f);
+		ASSERT_EQ(0, view.open(filename));
+		BitBoardS bbs;
+		EXPECT_EQ(-1, view.load_row(0, bbs));
+		EXPECT_EQ(0, view.load_row(2, bbs));
+		view.close();
+	}
+
+	//a row out of range is rejected before anything is written
+	FILE* f=fopen(filename, "rb");
+	fseek(f, 0, SEEK_END);
+	long size=ftell(f);
+	fclose(f);
+	BitBoardS bad(N+1000);
+	bad.set_bit(5); bad.set_bit(N+500);
+	ASSERT_EQ(0, w.open(filename, N, BBFileFormat::SPARSE));
+	ASSERT_EQ(0, w.append(rows[0]));
+	EXPECT_EQ(-1, w.append(bad));
+	ASSERT_EQ(0, w.append(rows[1]));
+	ASSERT_EQ(0, w.append(rows[2]));
+	ASSERT_EQ(0, w.close());
+	f=fopen(filename, "rb");
+	fseek(f, 0, SEEK_END);
+	EXPECT_EQ(size, ftell(f));
+	fclose(f);
+	remove(filename);
+
+	//not a valid file
+	f=fopen(filename, "wb");
+	fputs("not a bit string file, but long enough to contain a header of 64 bytes....", f);
+	fclose(f);
+	EXPECT_EQ(-1, view.open(filename));
+	EXPECT_FALSE(view.is_open());
+	remove(filename);
+}
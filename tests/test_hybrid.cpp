@@ -0,0 +1,189 @@
+//tests for sparse bit strings with hybrid containers (BitBoardH)
+
+#include <iostream>
+#include <set>
+
+#include "../bitscan.h"				//bit string library
+#include "google/gtest/gtest.h"
+
+using namespace std;
+
+TEST(Hybrid, setters_and_getters){
+	BitBoardH bbh(1000000);
+	EXPECT_TRUE(bbh.is_empty());
+
+	bbh.set_bit(10); bbh.set_bit(65536); bbh.set_bit(999999);
+	EXPECT_EQ(3, bbh.popcn64());
+	EXPECT_EQ(3, bbh.number_of_chunks());
+	EXPECT_TRUE(bbh.is_bit(65536));
+	EXPECT_FALSE(bbh.is_bit(65537));
+	EXPECT_EQ(-1, bbh.set_bit(1000000));							//outside population
+
+	bbh.erase_bit(65536);											//empty chunks are removed
+	EXPECT_EQ(2, bbh.number_of_chunks());
+	EXPECT_FALSE(bbh.is_bit(65536));
+	bbh.erase_bit();
+	EXPECT_TRUE(bbh.is_empty());
+}
+
+TEST(Hybrid, containers){
+	BitBoardH bbh;
+
+	//ARRAY->BITMAP when the population exceeds ARRAY_MAX
+	for(int i=0; i<=BitBoardH::ARRAY_MAX; i++)
+		bbh.set_bit(2*i);
+	EXPECT_EQ(BitBoardH::BITMAP, bbh.get_chunk(0).type);
+	EXPECT_EQ(BitBoardH::ARRAY_MAX+1, bbh.popcn64());
+	bbh.erase_bit(0);
+	EXPECT_EQ(BitBoardH::ARRAY, bbh.get_chunk(0).type);
+	EXPECT_TRUE(bbh.is_bit(2));
+	EXPECT_FALSE(bbh.is_bit(3));
+
+	//ranges are RUN containers
+	bbh.erase_bit();
+	bbh.set_bit(100, 50000);
+	bbh.set_bit(70000, 200000);
+	EXPECT_EQ(4, bbh.number_of_chunks());
+	EXPECT_EQ(BitBoardH::RUN, bbh.get_chunk(0).type);
+	EXPECT_EQ(BitBoardH::RUN, bbh.get_chunk(2).type);
+	EXPECT_EQ(49901+130001, bbh.popcn64());
+	EXPECT_TRUE(bbh.is_bit(50000));
+	EXPECT_FALSE(bbh.is_bit(50001));
+
+	//updates inside a run
+	bbh.erase_bit(1000);											//split
+	bbh.set_bit(50001);												//merge
+	EXPECT_EQ(BitBoardH::RUN, bbh.get_chunk(0).type);
+	EXPECT_EQ(2, bbh.get_chunk(0).number_of_runs());
+	EXPECT_FALSE(bbh.is_bit(1000));
+	EXPECT_TRUE(bbh.is_bit(50001));
+	bbh.set_bit(1000);
+	EXPECT_EQ(1, bbh.get_chunk(0).number_of_runs());
+
+	//optimize: a dense run stored as a bitmap becomes a RUN container
+	BitBoardH bbr;
+	for(int i=5000; i<15000; i++)
+		bbr.set_bit(i);
+	EXPECT_EQ(BitBoardH::BITMAP, bbr.get_chunk(0).type);
+	bbr.optimize();
+	EXPECT_EQ(BitBoardH::RUN, bbr.get_chunk(0).type);
+	EXPECT_EQ(10000, bbr.popcn64());
+}
+
+TEST(Hybrid, scanning){
+	BitBoardH bbh(500000);
+	set<int> sol;
+	for(int i=3; i<500000; i+=997){ bbh.set_bit(i); sol.insert(i);}		//ARRAY
+	bbh.set_bit(200000, 210000);											//RUN
+	for(int i=200000; i<=210000; i++) sol.insert(i);
+	for(int i=400000; i<420000; i+=3){ bbh.set_bit(i); sol.insert(i);}		//BITMAP
+
+	//non destructive
+	set<int> res;
+	bbh.init_scan(bbo::NON_DESTRUCTIVE);
+	for(int nBit=bbh.next_bit(); nBit!=EMPTY_ELEM; nBit=bbh.next_bit())
+		res.insert(nBit);
+	EXPECT_EQ(sol, res);
+
+	vector<int> rev;
+	bbh.init_scan(bbo::NON_DESTRUCTIVE_REVERSE);
+	for(int nBit=bbh.previous_bit(); nBit!=EMPTY_ELEM; nBit=bbh.previous_bit())
+		rev.push_back(nBit);
+	EXPECT_TRUE(equal(rev.begin(), rev.end(), sol.rbegin()));
+	EXPECT_EQ(sol.size(), rev.size());
+
+	//destructive
+	BitBoardH bbd(bbh);
+	rev.clear();
+	bbd.init_scan(bbo::DESTRUCTIVE_REVERSE);
+	for(int nBit=bbd.previous_bit_del(); nBit!=EMPTY_ELEM; nBit=bbd.previous_bit_del())
+		rev.push_back(nBit);
+	EXPECT_TRUE(equal(rev.begin(), rev.end(), sol.rbegin()));
+	EXPECT_TRUE(bbd.is_empty());
+
+	res.clear();
+	bbh.init_scan(bbo::DESTRUCTIVE);
+	for(int nBit=bbh.next_bit_del(); nBit!=EMPTY_ELEM; nBit=bbh.next_bit_del())
+		res.insert(nBit);
+	EXPECT_EQ(sol, res);
+	EXPECT_TRUE(bbh.is_empty());
+	EXPECT_EQ(0, bbh.init_scan(bbo::DESTRUCTIVE));							//empty chunks are kept
+	EXPECT_EQ(EMPTY_ELEM, bbh.next_bit_del());
+
+	bbh.optimize();															//removes the empty chunks
+	EXPECT_EQ(0, bbh.number_of_chunks());
+	EXPECT_EQ(EMPTY_ELEM, bbh.init_scan(bbo::NON_DESTRUCTIVE));
+}
+
+TEST(Hybrid, destructive_scan_array){
+	const int N=BitBoardH::ARRAY_MAX;
+	BitBoardH bbh;
+	for(int i=0; i<N; i++) bbh.set_bit(3*i);				//a full ARRAY container
+	ASSERT_EQ(BitBoardH::ARRAY, bbh.get_chunk(0).type);
+
+	//values are removed from the front lazily
+	bbh.init_scan(bbo::DESTRUCTIVE);
+	for(int i=0; i<100; i++)
+		EXPECT_EQ(3*i, bbh.next_bit_del());
+	EXPECT_EQ(100, bbh.get_chunk(0).head);
+	EXPECT_EQ(N-100, bbh.popcn64());
+	EXPECT_FALSE(bbh.is_bit(297));
+	EXPECT_TRUE(bbh.is_bit(300));
+	EXPECT_EQ(N-100, bbh.get_chunk(0).number_of_runs());
+
+	BBObject::scan_cursor sc;
+	bbh.init_scan(sc, bbo::NON_DESTRUCTIVE_REVERSE);
+	int nBit=EMPTY_ELEM, last=EMPTY_ELEM;
+	while((nBit=bbh.previous_bit(sc))!=EMPTY_ELEM) last=nBit;
+	EXPECT_EQ(300, last);
+
+	bbh.set_bit(0);															//before the remaining values
+	EXPECT_TRUE(bbh.is_bit(0));
+	EXPECT_EQ(99, bbh.get_chunk(0).head);
+	bbh.erase_bit(0);
+	EXPECT_FALSE(bbh.is_bit(0));
+
+	//the rest of the scan
+	for(int i=100; i<N; i++)
+		ASSERT_EQ(3*i, bbh.next_bit_del());
+	EXPECT_EQ(EMPTY_ELEM, bbh.next_bit_del());
+	EXPECT_TRUE(bbh.is_empty());
+	EXPECT_EQ(N, bbh.get_chunk(0).head);
+	bbh.optimize();
+	EXPECT_EQ(0, bbh.number_of_chunks());
+
+	//compaction
+	for(int i=0; i<1000; i++) bbh.set_bit(5*i);
+	bbh.init_scan(bbo::DESTRUCTIVE);
+	for(int i=0; i<10; i++) bbh.next_bit_del();
+	bbh.optimize();
+	EXPECT_EQ(0, bbh.get_chunk(0).head);
+	EXPECT_EQ(990, bbh.get_chunk(0).val.size());
+	EXPECT_EQ(50, bbh.get_chunk(0).next(0));
+}
+
+TEST(Hybrid, conversion){
+	BitBoardS bbs(2000000);
+	for(int i=0; i<2000000; i+=1013) bbs.set_bit(i);
+	bbs.set_bit(1000000, 1100000);
+
+	BitBoardH bbh(bbs);
+	EXPECT_EQ(bbs.popcn64(), bbh.popcn64());
+	EXPECT_LT(bbh.memory_bytes(), bbs.number_of_bitblocks()*sizeof(BitBoardS::elem));
+
+	vector<int> vs, vh;
+	bbs.to_vector(vs);
+	bbh.to_vector(vh);
+	EXPECT_EQ(vs, vh);
+
+	BitBoardS bbs2;
+	bbh.to_sparse(bbs2);
+	EXPECT_TRUE(bbs==bbs2);
+
+	//equality does not depend on the containers
+	BitBoardH bbh2;
+	for(int i=0; i<vs.size(); i++) bbh2.set_bit(vs[i]);
+	EXPECT_TRUE(bbh==bbh2);
+	bbh2.erase_bit(vs.back());
+	EXPECT_TRUE(bbh!=bbh2);
+}
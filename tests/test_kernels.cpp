@@ -0,0 +1,177 @@
+//tests for the vectorized kernels of bulk set operations
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "../bitscan.h"				//bit string library
+#include "google/gtest/gtest.h"
+
+using namespace std;
+
+class KernelTest: public ::testing::Test{
+protected:
+	virtual void SetUp(){
+		isa=BBKernel::get_isa();
+		srand(1);
+	}
+	virtual void TearDown(){
+		BBKernel::set_isa(isa);
+	}
+
+	//bit strings with population sizes which do not fill the vector registers
+	static void fill(BitBoardN& bb, double p){
+		for(int i=0; i<bb.number_of_bitblocks(); i++)
+			bb.get_bitboard(i)=gen_random_bitboard(p);
+	}
+	BBKernel::isa_t isa;
+};
+
+TEST_F(KernelTest, binary_operations){
+	const BBKernel::isa_t isas[]={BBKernel::SCALAR, BBKernel::SSE2, BBKernel::AVX2, BBKernel::AVX512};
+	const int sizes[]={1, 64, 65, 130, 300, 511, 1000, 1025, 20001};
+
+	for(int s=0; s<9; s++){
+		BitBoardN lhs(sizes[s]), rhs(sizes[s]);
+		fill(lhs, 0.5); fill(rhs, 0.3);
+		
+		for(int k=0; k<4; k++){
+			if(BBKernel::set_isa(isas[k])==-1) continue;
+			BitBoardN res(sizes[s]);
+
+			AND(lhs, rhs, res);
+			for(int i=0; i<lhs.number_of_bitblocks(); i++)
+				EXPECT_EQ(lhs.get_bitboard(i) & rhs.get_bitboard(i), res.get_bitboard(i));
+
+			OR(lhs, rhs, res);
+			for(int i=0; i<lhs.number_of_bitblocks(); i++)
+				EXPECT_EQ(lhs.get_bitboard(i) | rhs.get_bitboard(i), res.get_bitboard(i));
+
+			ERASE(lhs, rhs, res);
+			for(int i=0; i<lhs.number_of_bitblocks(); i++)
+				EXPECT_EQ(lhs.get_bitboard(i) &~ rhs.get_bitboard(i), res.get_bitboard(i));
+
+			res=lhs;
+			res^=rhs;
+			for(int i=0; i<lhs.number_of_bitblocks(); i++)
+				EXPECT_EQ(lhs.get_bitboard(i) ^ rhs.get_bitboard(i), res.get_bitboard(i));
+		
+			res.flip();
+			for(int i=0; i<lhs.number_of_bitblocks(); i++)
+				EXPECT_EQ(~(lhs.get_bitboard(i) ^ rhs.get_bitboard(i)), res.get_bitboard(i));
+		}
+	}
+}
+
+TEST_F(KernelTest, range_operations){
+	const BBKernel::isa_t isas[]={BBKernel::SCALAR, BBKernel::SSE2, BBKernel::AVX2, BBKernel::AVX512};
+	BBIntrin lhs(1000), rhs(1000);
+	fill(lhs, 0.5); fill(rhs, 0.5);
+	
+	for(int k=0; k<4; k++){
+		if(BBKernel::set_isa(isas[k])==-1) continue;
+		BBIntrin res(1000);
+		res.set_bit();
+		AND(3, 8, lhs, rhs, res);
+		for(int i=0; i<res.number_of_bitblocks(); i++){
+			if(i<3 || i>8) EXPECT_EQ(ONE, res.get_bitboard(i));
+			else EXPECT_EQ(lhs.get_bitboard(i) & rhs.get_bitboard(i), res.get_bitboard(i));
+		}
+
+		res=lhs;
+		res.AND_EQ(5, rhs);
+		for(int i=0; i<res.number_of_bitblocks(); i++){
+			if(i<5) EXPECT_EQ(lhs.get_bitboard(i), res.get_bitboard(i));
+			else EXPECT_EQ(lhs.get_bitboard(i) & rhs.get_bitboard(i), res.get_bitboard(i));
+		}
+	}
+}
+
+TEST_F(KernelTest, aliasing){
+	BBIntrin lhs(700), rhs(700);
+	fill(lhs, 0.5); fill(rhs, 0.5);
+	BBIntrin copy(lhs);
+
+	AND(lhs, rhs, lhs);							//res aliased with lhs
+	for(int i=0; i<lhs.number_of_bitblocks(); i++)
+		EXPECT_EQ(copy.get_bitboard(i) & rhs.get_bitboard(i), lhs.get_bitboard(i));
+	
+	EXPECT_GE(BBKernel::get_isa(), BBKernel::SCALAR);
+	cout<<"kernels: "<<BBKernel::isa_name(BBKernel::get_isa())<<endl;
+}
+
+TEST_F(KernelTest, fused_popcount){
+	const BBKernel::isa_t isas[]={BBKernel::SCALAR, BBKernel::SSE2, BBKernel::AVX2, BBKernel::AVX512};
+	const int sizes[]={1, 65, 300, 4096, 4097, 5000, 20001};
+
+	for(int s=0; s<7; s++){
+		BBIntrin lhs(sizes[s]), rhs(sizes[s]), res(sizes[s]);
+		fill(lhs, 0.5); fill(rhs, 0.3);
+
+		for(int k=0; k<4; k++){
+			if(BBKernel::set_isa(isas[k])==-1) continue;
+			
+			EXPECT_EQ(AND(lhs, rhs, res).popcn64(), lhs.popcount_and(rhs));
+			EXPECT_EQ(OR(lhs, rhs, res).popcn64(), lhs.popcount_or(rhs));
+			EXPECT_EQ(ERASE(lhs, rhs, res).popcn64(), lhs.popcount_andnot(rhs));
+			res=lhs; res^=rhs;
+			EXPECT_EQ(res.popcn64(), lhs.popcount_xor(rhs));
+			EXPECT_EQ(lhs.popcn64(), BBKernel::bb_popc(lhs.get_bitstring(), lhs.number_of_bitblocks()));
+		}
+	}
+}
+
+TEST_F(KernelTest, decode){
+	const int POP=5000;
+	BBIntrin bb(POP);
+	BitBoardS bbs(POP);
+	for(int d=0; d<3; d++){
+		double p=(d==0)? 0.01 : (d==1)? 0.5 : 0.99;
+		bb.erase_bit();
+		for(int i=0; i<POP; i++){
+			if(UniformBoolean(p)) bb.set_bit(i);
+		}
+		bbs.init(POP);
+		for(int v : bb.bits()) bbs.set_bit(v);
+
+		vector<int> sol;
+		for(int v : bb.bits()) sol.push_back(v);
+		const int pc=sol.size();
+
+		for(int isa=BBKernel::SCALAR; isa<=BBKernel::AVX512; isa++){
+			if(BBKernel::set_isa((BBKernel::isa_t)isa)==-1) continue;
+			vector<int> out(pc+1, -1);
+
+			//full, exact buffer
+			EXPECT_EQ(pc, bb.decode(&out[0], pc));
+			EXPECT_TRUE(equal(sol.begin(), sol.end(), out.begin()));
+			EXPECT_EQ(-1, out[pc]);									//no overflow
+			
+			//truncated
+			std::fill(out.begin(), out.end(), -1);
+			EXPECT_EQ(pc/2, bb.decode(&out[0], pc/2));
+			EXPECT_TRUE(equal(sol.begin(), sol.begin()+pc/2, out.begin()));
+			EXPECT_EQ(-1, out[pc/2]);
+
+			//sparse 
+			std::fill(out.begin(), out.end(), -1);
+			EXPECT_EQ(pc, bbs.decode(&out[0], pc));
+			EXPECT_TRUE(equal(sol.begin(), sol.end(), out.begin()));
+						
+			vector<int> lv;
+			bb.to_vector(lv);
+			EXPECT_EQ(sol, lv);
+			bbs.to_vector(lv);
+			EXPECT_EQ(sol, lv);
+		}
+	}
+
+	//sentinel range
+	BBSentinel bbsent(1000);
+	bbsent.set_bit(300); bbsent.set_bit(700);
+	bbsent.update_sentinels();
+	int out[2];
+	EXPECT_EQ(2, bbsent.decode(out, 2));
+	EXPECT_EQ(300, out[0]);
+	EXPECT_EQ(700, out[1]);
+}
@@ -0,0 +1,191 @@
+//tests for bit matrices in a contiguous slab (BitMatrix)
+
+#include <iostream>
+#include <vector>
+#include <climits>
+
+#include "../bitscan.h"				//bit string library
+#include "google/gtest/gtest.h"
+
+using namespace std;
+
+//records the size requested, allocation always fails
+class RecordingAlloc: public BBNullAlloc{
+public:
+	RecordingAlloc():requested(0){}
+	BITBOARD* allocate(size_t nBB)					{requested=nBB; return NULL;}
+	size_t requested;
+};
+
+TEST(Matrix, setters_and_getters){
+	BitMatrix m(130, 130);
+	EXPECT_EQ(130, m.number_of_rows());
+	EXPECT_EQ(130, m.number_of_cols());
+	EXPECT_EQ(0, m.stride()%(_MEM_ALIGNMENT/sizeof(BITBOARD)));				//rows padded to cache lines
+	EXPECT_EQ(0, (size_t)m.get_slab()%_MEM_ALIGNMENT);
+	EXPECT_EQ(INDEX_1TO1(130), m.row(5).number_of_bitblocks());
+
+	//rows are views of the slab
+	m.set_symmetric(3, 129);
+	EXPECT_TRUE(m.row(3).is_bit(129));
+	EXPECT_TRUE(m[129].is_bit(3));
+	m.row(10).set_bit(0, 64);
+	EXPECT_TRUE(m.is_bit(10, 64));
+	EXPECT_FALSE(m.is_bit(11, 0));
+	EXPECT_EQ(m.get_slab()+10*m.stride(), m.row(10).get_bitstring());
+	m.erase_bit(10, 64);
+	EXPECT_EQ(64, m.row(10).popcn64());
+
+	m.erase_bit();
+	for(int i=0; i<m.number_of_rows(); i++)
+		EXPECT_TRUE(m.row(i).is_empty());
+
+	//the slab of large matrices exceeds the range of int (in bitblocks)
+	RecordingAlloc alloc;
+	BitMatrix mbig(0, 0, alloc);
+	EXPECT_EQ(-1, mbig.init(400000, 400000));
+	const size_t line=_MEM_ALIGNMENT/sizeof(BITBOARD);
+	EXPECT_EQ(400000*((INDEX_1TO1(400000)+line-1)/line*line), alloc.requested);
+	EXPECT_LT((size_t)INT_MAX, alloc.requested);
+	EXPECT_EQ(0, mbig.stride());
+	EXPECT_EQ(0, mbig.number_of_rows());
+}
+
+TEST(Matrix, row_views){
+	const int N=300;
+	BitMatrix m(N, N);
+	for(int i=0; i<N; i++){
+		for(int j=i+1; j<N; j++)
+			if((i+j)%3==0) m.set_symmetric(i, j);
+	}
+
+	//set algebra between rows
+	BBIntrin res(N);
+	AND(m[1], m[2], res);
+	EXPECT_EQ(m[1].popcount_and(m[2]), res.popcn64());
+	BBIntrin cand(m[1]);														//owns its bitblocks
+	cand&=m[2];
+	EXPECT_TRUE(cand==res);
+	EXPECT_NE(m[1].get_bitstring(), cand.get_bitstring());
+
+	//non destructive scan with an external cursor
+	BBIntrin::scan_t sc;
+	const BBIntrin& r=m[7];
+	vector<int> v;
+	r.init_scan(sc, bbo::NON_DESTRUCTIVE);
+	for(int nBit=r.next_bit(sc); nBit!=EMPTY_ELEM; nBit=r.next_bit(sc))
+		v.push_back(nBit);
+	EXPECT_EQ(r.popcn64(), v.size());
+	for(int i=0; i<v.size(); i++)
+		EXPECT_EQ(0, (7+v[i])%3);
+
+	//sentinel views (destructive scans update the row in the slab)
+	m[9].erase_bit();
+	m.set_bit(9, 100); m.set_bit(9, 200);
+	BBSentinelView sv=m.sentinel_row(9);
+	EXPECT_EQ(WDIV(100), sv.get_sentinel_L());
+	EXPECT_EQ(WDIV(200), sv.get_sentinel_H());
+	sv.init_scan(bbo::DESTRUCTIVE);
+	EXPECT_EQ(100, sv.next_bit_del());
+	EXPECT_FALSE(m.is_bit(9, 100));
+	EXPECT_TRUE(m.is_bit(9, 200));
+}
+
+TEST(Matrix, row_assignment){
+	BitMatrix m(4, 100);
+	const BITBOARD* slab=m.get_slab();
+
+	//bits are copied into the slab
+	BBIntrin bb(100);
+	bb.set_bit(7); bb.set_bit(99);
+	m[1]=bb;
+	EXPECT_TRUE(m.is_bit(1, 7));
+	EXPECT_TRUE(m.is_bit(1, 99));
+	EXPECT_EQ(slab+m.stride(), m[1].get_bitstring());
+
+	m[2]=BBIntrin(bb);															//temporaries are copied too
+	EXPECT_TRUE(m.is_bit(2, 7));
+	EXPECT_EQ(slab+2*m.stride(), m[2].get_bitstring());
+	m[3]=m[2];
+	EXPECT_TRUE(m.is_bit(3, 99));
+	EXPECT_EQ(slab+3*m.stride(), m[3].get_bitstring());
+
+	//through references to the base classes
+	BitBoardN& rn=m[0];
+	rn=bb;
+	EXPECT_TRUE(m.is_bit(0, 7));
+	BBIntrin& ri=m[0];
+	ri=BBIntrin(100);															//move assignment copies the bits
+	EXPECT_TRUE(m[0].is_empty());
+	EXPECT_EQ(slab, m[0].get_bitstring());
+
+	//other sizes are rejected and the rows are unchanged
+	BBIntrin big(300);
+	big.set_bit(250);
+	m.row(1)=big;
+	rn=big;
+	ri=big;
+	ri=BBIntrin(300);
+	EXPECT_EQ(INDEX_1TO1(100), m[1].number_of_bitblocks());
+	EXPECT_EQ(INDEX_1TO1(100), m[0].number_of_bitblocks());
+	EXPECT_EQ(2, m[1].popcn64());
+	EXPECT_TRUE(m[0].is_empty());
+	EXPECT_EQ(slab, m[0].get_bitstring());
+	EXPECT_EQ(-1, ri.resize(300));
+	EXPECT_EQ(-1, ri.reserve(300));
+	ri.init(300);
+	EXPECT_EQ(INDEX_1TO1(100), m[0].number_of_bitblocks());
+
+	//sentinel views
+	BBSentinelView sv=m.sentinel_row(2);
+	BBSentinel bbs(100);
+	bbs.set_bit(40); bbs.set_bit(80);
+	sv=bbs;
+	EXPECT_FALSE(m.is_bit(2, 7));
+	EXPECT_TRUE(m.is_bit(2, 80));
+	EXPECT_EQ(WDIV(40), sv.get_sentinel_L());
+	EXPECT_EQ(WDIV(80), sv.get_sentinel_H());
+	sv=BBSentinel(300);
+	EXPECT_TRUE(m.is_bit(2, 40));
+	EXPECT_EQ(slab+2*m.stride(), sv.get_bitstring());
+}
+
+TEST(Matrix, transpose){
+	//kernel, for all the instruction sets supported by the CPU
+	BITBOARD a[64], t[64];
+	for(int i=0; i<64; i++) a[i]=(0x9E3779B97F4A7C15ULL*(i+1))^((BITBOARD)i<<7);
+	BBKernel::isa_t isa=BBKernel::get_isa();
+	BBKernel::isa_t all[]={BBKernel::SCALAR, BBKernel::SSE2, BBKernel::AVX2};
+	for(int n=0; n<3; n++){
+		if(BBKernel::set_isa(all[n])==-1) continue;
+		copy(a, a+64, t);
+		BBKernel::bb_transpose64(t);
+		for(int i=0; i<64; i++)
+			for(int j=0; j<64; j++)
+				ASSERT_EQ((bool)(a[i]&Tables::mask[j]), (bool)(t[j]&Tables::mask[i]));
+		BBKernel::bb_transpose64(t);
+		EXPECT_TRUE(equal(a, a+64, t));
+	}
+	BBKernel::set_isa(isa);
+
+	//rectangular matrix
+	BitMatrix m(150, 200), mt;
+	for(int i=0; i<150; i++)
+		for(int j=(i*7)%5; j<200; j+=i%13+1) m.set_bit(i, j);
+	ASSERT_EQ(0, m.transpose(mt));
+	EXPECT_EQ(200, mt.number_of_rows());
+	EXPECT_EQ(150, mt.number_of_cols());
+	for(int i=0; i<150; i++)
+		for(int j=0; j<200; j++)
+			ASSERT_EQ(m.is_bit(i, j), mt.is_bit(j, i));
+	for(int j=0; j<200; j++)
+		EXPECT_TRUE(mt[j].popcn64()<=150);									//no bits beyond the source rows
+
+	//rows of bitarrays (in-neighbors of a directed graph)
+	vector<BBIntrin> g(100, BBIntrin(100)), gt;
+	for(int i=0; i<100; i++) g[i].set_bit((i*i+1)%100);
+	BitMatrix::transpose(g, 100, gt);
+	EXPECT_EQ(100, gt.size());
+	for(int i=0; i<100; i++)
+		EXPECT_TRUE(gt[(i*i+1)%100].is_bit(i));
+}
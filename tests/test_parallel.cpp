@@ -0,0 +1,175 @@
+//tests for the multithreaded bulk operations of dense bit strings (BBParallel, BBThreadPool)
+
+#include <iostream>
+#include <atomic>
+
+#include "../bitscan.h"				//bit string library
+#include "google/gtest/gtest.h"
+
+using namespace std;
+
+TEST(Parallel, thread_pool){
+	BBThreadPool pool(4);
+	EXPECT_EQ(4, pool.number_of_threads());
+
+	//every index is visited exactly once
+	const int N=100003;
+	vector<atomic<int> > visits(N);
+	for(int i=0; i<N; i++) visits[i]=0;
+	for(int rep=0; rep<3; rep++){
+		pool.run(N, 100, [&](int begin, int end){
+			for(int i=begin; i<end; i++) visits[i]++;
+		});
+	}
+	for(int i=0; i<N; i++)
+		ASSERT_EQ(3, visits[i]);
+
+	//single chunk
+	atomic<int> ncalls(0);
+	pool.run(10, 100, [&](int begin, int end){ ncalls++; EXPECT_EQ(0, begin); EXPECT_EQ(10, end);});
+	EXPECT_EQ(1, ncalls);
+}
+
+TEST(Parallel, bulk_operations){
+	BBThreadPool pool(4);
+	const int N=WMUL(PARALLEL_MIN_BLOCKS)+1000;						//above the threshold
+	BitBoardN bb1(N), bb2(N), res(N), sol(N);
+	for(int i=0; i<N; i+=3) bb1.set_bit(i);
+	for(int i=0; i<N; i+=5) bb2.set_bit(i);
+	ASSERT_TRUE(BBParallel::is_parallel(bb1.number_of_bitblocks()));
+
+	EXPECT_EQ(bb1.popcn64(), BBParallel::popcn64(bb1, pool));
+	EXPECT_EQ((N+14)/15, BBParallel::popcount_and(bb1, bb2, pool));
+
+	AND(bb1, bb2, sol);
+	EXPECT_TRUE(sol==BBParallel::AND(bb1, bb2, res, pool));
+	OR(bb1, bb2, sol);
+	EXPECT_TRUE(sol==BBParallel::OR(bb1, bb2, res, pool));
+	ERASE(bb1, bb2, sol);
+	EXPECT_TRUE(sol==BBParallel::ERASE(bb1, bb2, res, pool));
+
+	sol=bb1;
+	sol.flip();
+	res=bb1;
+	EXPECT_TRUE(sol==BBParallel::flip(res, pool));
+
+	BBParallel::erase_bit(res, pool);
+	EXPECT_TRUE(res.is_empty());
+
+	//default pool
+	EXPECT_EQ(bb1.popcn64(), BBParallel::popcn64(bb1));
+}
+
+TEST(Parallel, early_exit){
+	BBThreadPool pool(4);
+	const int N=WMUL(PARALLEL_MIN_BLOCKS)*4;
+	BitBoardN bb1(N), bb2(N);
+
+	EXPECT_TRUE(BBParallel::is_empty(bb1, pool));
+	EXPECT_TRUE(BBParallel::is_disjoint(bb1, bb2, pool));
+
+	bb1.set_bit(N-1);
+	EXPECT_FALSE(BBParallel::is_empty(bb1, pool));
+	EXPECT_TRUE(BBParallel::is_disjoint(bb1, bb2, pool));
+
+	bb1.set_bit(10);
+	bb2.set_bit(10);
+	EXPECT_FALSE(BBParallel::is_disjoint(bb1, bb2, pool));
+	bb2.erase_bit(10);
+	bb2.set_bit(N/2);
+	EXPECT_TRUE(BBParallel::is_disjoint(bb1, bb2, pool));
+
+	//serial fallback below the threshold
+	BitBoardN bbs(1000);
+	EXPECT_TRUE(BBParallel::is_empty(bbs, pool));
+	bbs.set_bit(999);
+	EXPECT_FALSE(BBParallel::is_empty(bbs, pool));
+	EXPECT_EQ(1, BBParallel::popcn64(bbs, pool));
+}
+
+TEST(Parallel, run_stealing){
+	BBThreadPool pool(4);
+	const int NTASKS=1000;
+	vector<atomic<int> > visits(NTASKS);
+	for(int i=0; i<NTASKS; i++) visits[i]=0;
+
+	//uneven cost: the first tasks are much heavier
+	pool.run_stealing(NTASKS, [&](int k){
+		volatile long long sink=0;
+		for(int i=0; i<(k<50? 100000 : 10); i++) sink+=i;
+		visits[k]++;
+	});
+	for(int i=0; i<NTASKS; i++)
+		ASSERT_EQ(1, visits[i]);
+}
+
+TEST(Parallel, partition){
+	const int N=64*1000;
+	BBIntrin bbi(N);
+	for(int i=0; i<640; i++) bbi.set_bit(i);					//clustered population
+	for(int i=640; i<N; i+=640) bbi.set_bit(i);
+
+	vector<int> bounds;
+	BBParallel::partition(bbi.get_bitstring(), 0, bbi.number_of_bitblocks(), 8, bounds);
+	ASSERT_LE(2, bounds.size());
+	EXPECT_GE(9, bounds.size());
+	EXPECT_EQ(0, bounds.front());
+	EXPECT_EQ(bbi.number_of_bitblocks(), bounds.back());
+	for(int k=0; k+1<bounds.size(); k++){
+		ASSERT_LT(bounds[k], bounds[k+1]);
+		EXPECT_LT(0, BBKernel::bb_popc(bbi.get_bitstring()+bounds[k], bounds[k+1]-bounds[k]));
+	}
+	EXPECT_GE(10, bounds[4]);									//half of the population is in the first 10 bitblocks
+
+	//empty
+	BBIntrin bbe(N);
+	BBParallel::partition(bbe.get_bitstring(), 0, bbe.number_of_bitblocks(), 8, bounds);
+	EXPECT_TRUE(bounds.empty());
+}
+
+TEST(Parallel, for_each_bit){
+	BBThreadPool pool(4);
+	const int N=100000;
+	BBIntrin bbi(N);
+	BBSentinel bbsent(N);
+	BBIntrinS bbs(N);
+	vector<int> sol;
+	for(int i=0; i<N; i++){
+		if((i>=1000 && i<3000) || (i>50000 && i%777==0) || i==N-1){
+			bbi.set_bit(i);
+			bbsent.set_bit(i);
+			bbs.set_bit(i);
+			sol.push_back(i);
+		}
+	}
+	bbsent.update_sentinels();
+
+	vector<atomic<int> > visits(N);
+	for(int rev=0; rev<2; rev++){
+		for(int type=0; type<3; type++){
+			for(int i=0; i<N; i++) visits[i]=0;
+			auto fn=[&](int bit){visits[bit]++;};
+			switch(type){
+			case 0: BBParallel::for_each_bit(bbi, fn, rev, pool); break;
+			case 1: BBParallel::for_each_bit(bbsent, fn, rev, pool); break;
+			case 2: BBParallel::for_each_bit(bbs, fn, rev, pool); break;
+			}
+			for(int i=0; i<N; i++)
+				ASSERT_EQ(bbi.is_bit(i)? 1 : 0, visits[i]);
+		}
+	}
+
+	//with a single thread the order is that of the non destructive scans
+	BBThreadPool single(1);
+	vector<int> order;
+	BBParallel::for_each_bit(bbs, [&](int bit){order.push_back(bit);}, false, single);
+	EXPECT_EQ(sol, order);
+	order.clear();
+	BBParallel::for_each_bit(bbi, [&](int bit){order.push_back(bit);}, true, single);
+	EXPECT_EQ(vector<int>(sol.rbegin(), sol.rend()), order);
+
+	//empty
+	BBSentinel bbempty(N);
+	bbempty.update_sentinels();
+	BBParallel::for_each_bit(bbempty, [&](int){ADD_FAILURE();}, false, pool);
+}
@@ -0,0 +1,69 @@
+//tests for the rank/select directory of dense bit strings (BBRankSelect)
+
+#include <iostream>
+#include <vector>
+
+#include "../bitscan.h"				//bit string library
+#include "google/gtest/gtest.h"
+
+using namespace std;
+
+TEST(RankSelect, rank_and_select){
+	const int N=100000;
+	BBIntrin bbi(N);
+	vector<int> sol;
+	for(int i=0; i<N; i++){
+		if((i%7==0 && i<30000) || (i>60000 && i%1003==0) || (i>=90000 && i<99000)){
+			bbi.set_bit(i);
+			sol.push_back(i);
+		}
+	}
+
+	BBRankSelect rs(bbi);
+	EXPECT_EQ(sol.size(), rs.popcn64());
+	EXPECT_EQ(bbi.popcn64(), rs.popcn64());
+
+	//rank
+	int r=0;
+	for(int i=0; i<N; i++){
+		ASSERT_EQ(r, rs.rank(i));
+		if(bbi.is_bit(i)) r++;
+	}
+	EXPECT_EQ(r, rs.rank(N));
+	EXPECT_EQ(bbi.popcn64(77777), rs.popcn64(77777));
+
+	//select
+	for(int k=0; k<sol.size(); k++)
+		ASSERT_EQ(sol[k], rs.select(k));
+	EXPECT_EQ(EMPTY_ELEM, rs.select(sol.size()));
+	EXPECT_EQ(EMPTY_ELEM, rs.select(-1));
+
+	//space overhead
+	EXPECT_LT(rs.memory_bytes(), 0.05*bbi.number_of_bitblocks()*sizeof(BITBOARD));
+}
+
+TEST(RankSelect, border_cases){
+	BitBoardN empty(5000);
+	BBRankSelect rs(empty);
+	EXPECT_EQ(0, rs.popcn64());
+	EXPECT_EQ(0, rs.rank(4999));
+	EXPECT_EQ(EMPTY_ELEM, rs.select(0));
+
+	//full bit string (basic blocks of 512 1-bits)
+	BitBoardN full(10000);
+	full.set_bit(0, 9999);
+	rs.build(full);
+	EXPECT_EQ(10000, rs.popcn64());
+	EXPECT_EQ(5000, rs.rank(5000));
+	EXPECT_EQ(9999, rs.select(9999));
+	EXPECT_EQ(2048, rs.select(2048));
+
+	//single bits at the end of a block
+	BitBoardN bbn(1000000);
+	bbn.set_bit(63); bbn.set_bit(2047); bbn.set_bit(999999);
+	rs.build(bbn);
+	EXPECT_EQ(63, rs.select(0));
+	EXPECT_EQ(2047, rs.select(1));
+	EXPECT_EQ(999999, rs.select(2));
+	EXPECT_EQ(2, rs.rank(999999));
+}
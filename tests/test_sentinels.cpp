@@ -66,4 +66,82 @@ TEST(Sentinel, basic){
 
 				
 	cout<<"--------------------------------------------------"<<endl;
-}
\ No newline at end of file
+}
+
+TEST(Sentinel, fused_popcount){
+	BBSentinel bbs(1000);
+	BBIntrin bbi(1000);
+	bbs.set_bit(100); bbs.set_bit(200); bbs.set_bit(300);
+	bbs.update_sentinels();
+	bbi.set_bit(10); bbi.set_bit(200); bbi.set_bit(300); bbi.set_bit(900);
+	
+	EXPECT_EQ(2, bbs.popcount_and(bbi));
+	EXPECT_EQ(1, bbs.popcount_andnot(bbi));
+	EXPECT_EQ(5, bbs.popcount_or(bbi));						//rhs bits outside the sentinel range
+	EXPECT_EQ(3, bbs.popcount_xor(bbi));
+
+	const BitBoardN& ref=bbs;								//sentinel range through the base class
+	EXPECT_EQ(2, ref.popcount_and(bbi));
+
+	bbs.erase_bit(); 
+	bbs.update_sentinels();
+	EXPECT_EQ(0, bbs.popcount_and(bbi));
+	EXPECT_EQ(4, bbs.popcount_or(bbi));
+}
+TEST(Sentinel, tracking){
+	BBSentinel bbs(1000);
+	bbs.set_bit(300);
+	bbs.set_tracking();										//fits the sentinels
+	EXPECT_TRUE(bbs.is_tracking());
+	EXPECT_EQ(WDIV(300), bbs.get_sentinel_L());
+	EXPECT_EQ(WDIV(300), bbs.get_sentinel_H());
+
+	//set_bit only moves the sentinels outwards
+	bbs.set_bit(100);
+	bbs.set_bit(900);
+	EXPECT_EQ(WDIV(100), bbs.get_sentinel_L());
+	EXPECT_EQ(WDIV(900), bbs.get_sentinel_H());
+
+	//erase_bit only moves the sentinels inwards
+	bbs.erase_bit(900);
+	EXPECT_EQ(WDIV(300), bbs.get_sentinel_H());
+	bbs.erase_bit(100);
+	bbs.erase_bit(300);
+	EXPECT_EQ(EMPTY_ELEM, bbs.get_sentinel_L());
+	EXPECT_EQ(EMPTY_ELEM, bbs.get_sentinel_H());
+	bbs.set_bit(500);
+	EXPECT_EQ(WDIV(500), bbs.get_sentinel_L());
+	EXPECT_EQ(WDIV(500), bbs.get_sentinel_H());
+
+	//ranges and OR
+	bbs.set_bit(70, 130);
+	EXPECT_EQ(WDIV(70), bbs.get_sentinel_L());
+	BitBoardN bbn(1000);
+	bbn.set_bit(10); bbn.set_bit(950);
+	bbs.set_bit(bbn);
+	EXPECT_EQ(WDIV(10), bbs.get_sentinel_L());
+	EXPECT_EQ(WDIV(950), bbs.get_sentinel_H());
+
+	//AND, &= and erase_bit(BitBoardN) fit the sentinels in the same pass
+	BBSentinel bbc(bbs);
+	EXPECT_TRUE(bbc.is_tracking());
+	bbc&=bbn;
+	EXPECT_EQ(2, bbc.popcn64());
+	bbc.erase_bit(bbn);
+	EXPECT_EQ(EMPTY_ELEM, bbc.get_sentinel_L());
+	bbc&=bbn;												//empty sentinels
+	EXPECT_TRUE(bbc.is_empty());
+
+	BitBoardN mid(1000);
+	mid.set_bit(100, 600);
+	BBSentinel res(1000);
+	res.set_tracking();
+	AND(mid, bbs, res);
+	EXPECT_EQ(WDIV(100), res.get_sentinel_L());
+	EXPECT_EQ(WDIV(500), res.get_sentinel_H());
+	EXPECT_EQ(32, res.popcn64());
+
+	bbs.erase_bit();										//in sentinel range
+	EXPECT_EQ(EMPTY_ELEM, bbs.get_sentinel_H());
+	EXPECT_TRUE(bbs.is_empty());
+}
@@ -832,3 +832,193 @@ TEST(Sparse, keep_operations) {
 }
 
 
+
+TEST(Sparse_intrinsic, range_for){
+	BBIntrinS bbs(10000);
+	vector<int> sol;
+	for(int i=3; i<10000; i+=333){
+		bbs.set_bit(i);
+		sol.push_back(i);
+	}
+	bbs.set_bit(500); bbs.erase_bit(500);					//empty block in the collection
+	sol.erase(remove(sol.begin(), sol.end(), 500), sol.end());
+
+	vector<int> res;
+	for(int v : bbs.bits()) res.push_back(v);
+	EXPECT_EQ(sol, res);
+
+	res.clear();
+	for(int v : bbs.bits_reverse()) res.insert(res.begin(), v);
+	EXPECT_EQ(sol, res);
+
+	BitBoardS empty(1000);
+	EXPECT_TRUE(empty.bits().empty());
+}
+
+TEST(Sparse_intrinsic, external_cursor){
+	BBIntrinS bbs(10000);
+	vector<int> sol;
+	for(int i=10; i<10000; i+=501){
+		bbs.set_bit(i);
+		sol.push_back(i);
+	}
+	const BBIntrinS& cbb=bbs;
+
+	bbo::scan_cursor c1, c2;
+	cbb.init_scan(c1, bbo::NON_DESTRUCTIVE);
+	cbb.init_scan(c2, bbo::NON_DESTRUCTIVE_REVERSE);
+	for(int i=0; i<sol.size(); i++){
+		EXPECT_EQ(sol[i], cbb.next_bit(c1));
+		EXPECT_EQ(sol[sol.size()-1-i], cbb.previous_bit(c2));
+	}
+	EXPECT_EQ(EMPTY_ELEM, cbb.next_bit(c1));
+
+	int nBB=EMPTY_ELEM;
+	cbb.init_scan_from(c1, 1000, bbo::NON_DESTRUCTIVE);
+	EXPECT_EQ(1012, cbb.next_bit(c1, nBB));
+	EXPECT_EQ(WDIV(1012), nBB);
+
+	//destructive
+	vector<int> res;
+	int nBit;
+	bbs.init_scan(c1, bbo::DESTRUCTIVE);
+	while((nBit=bbs.next_bit_del(c1))!=EMPTY_ELEM) res.push_back(nBit);
+	EXPECT_EQ(sol, res);
+	EXPECT_TRUE(bbs.is_empty());
+}
+
+TEST(Sparse, galloping_set_operations){
+	//skewed (one block every 100 against every block) and balanced operands
+	BitBoardS small(640000), big(640000), bal(640000);
+	set<int> ss, sb, sbal;
+	for(int i=3; i<640000; i+=6400){ small.set_bit(i); ss.insert(i);}
+	for(int i=0; i<640000; i+=61){ big.set_bit(i); sb.insert(i);}
+	for(int i=5; i<640000; i+=173){ bal.set_bit(i); sbal.insert(i);}
+	small.set_bit(639999); ss.insert(639999);						//beyond the last block of big
+
+	set<int> sand, sor;
+	set_intersection(ss.begin(), ss.end(), sb.begin(), sb.end(), inserter(sand, sand.begin()));
+	set_union(ss.begin(), ss.end(), sb.begin(), sb.end(), inserter(sor, sor.begin()));
+	vector<int> vand(sand.begin(), sand.end()), vor(sor.begin(), sor.end()), v;
+	EXPECT_FALSE(vand.empty());
+
+	BitBoardS res;
+	AND(small, big, res);	res.to_vector(v);	EXPECT_EQ(vand, v);
+	AND(big, small, res);	res.to_vector(v);	EXPECT_EQ(vand, v);
+	OR(small, big, res);	res.to_vector(v);	EXPECT_EQ(vor, v);
+	OR(big, small, res);	res.to_vector(v);	EXPECT_EQ(vor, v);
+
+	BitBoardS bb(big);		bb&=small;	bb.to_vector(v);	EXPECT_EQ(vand, v);
+	bb=small;				bb&=big;	bb.to_vector(v);	EXPECT_EQ(vand, v);
+	bb=big;					bb|=small;	bb.to_vector(v);	EXPECT_EQ(vor, v);
+	bb=small;				bb|=big;	bb.to_vector(v);	EXPECT_EQ(vor, v);
+
+	EXPECT_FALSE(small.is_disjoint(big));
+	EXPECT_FALSE(big.is_disjoint(small));
+	ERASE(small, big, res);
+	EXPECT_TRUE(res.is_disjoint(big));
+	EXPECT_TRUE(big.is_disjoint(res));
+
+	//balanced: |= adds the blocks which are only in rhs
+	set<int> sbor;
+	set_union(sbal.begin(), sbal.end(), sb.begin(), sb.end(), inserter(sbor, sbor.begin()));
+	bb=bal;		bb|=big;	bb.to_vector(v);
+	EXPECT_EQ(vector<int>(sbor.begin(), sbor.end()), v);
+}
+
+TEST(Sparse, compaction){
+	BitBoardS bb(1000), rhs(1000);
+	for(int i=0; i<1000; i+=10) bb.set_bit(i);						//100 bits in 16 blocks
+	rhs.set_bit(0); rhs.set_bit(500);
+
+	//lax mode: empty blocks are kept
+	BitBoardS lax(bb);
+	lax&=rhs;
+	EXPECT_EQ(bb.number_of_bitblocks(), lax.number_of_bitblocks());
+	EXPECT_EQ(2, lax.popcn64());
+	EXPECT_EQ(bb.number_of_bitblocks()-2, lax.compact());
+	EXPECT_EQ(2, lax.number_of_bitblocks());
+	EXPECT_EQ(0, lax.compact());
+
+	//lax mode with skewed sizes (galloping): the same blocks are kept
+	BitBoardS big(100000), small(100000);
+	for(int i=0; i<100000; i+=20) big.set_bit(i);
+	small.set_bit(640); small.set_bit(50000); small.set_bit(99999);
+	ASSERT_LT(GALLOP_RATIO*small.number_of_bitblocks(), big.number_of_bitblocks());
+	const int nBB=big.number_of_bitblocks();
+	big&=small;
+	EXPECT_EQ(nBB, big.number_of_bitblocks());
+	EXPECT_EQ(2, big.popcn64());
+	EXPECT_TRUE(big.is_bit(640));
+	EXPECT_TRUE(big.is_bit(50000));
+	EXPECT_EQ(640, big.lsbn64());
+	BitBoardS cbig(100000);
+	for(int i=0; i<100000; i+=20) cbig.set_bit(i);
+	cbig.set_auto_compact();
+	cbig&=small;
+	EXPECT_EQ(2, cbig.number_of_bitblocks());
+	EXPECT_EQ(nBB-2, big.compact());
+	EXPECT_TRUE(cbig==big);
+
+	//auto compaction
+	BitBoardS cbb(bb);
+	cbb.set_auto_compact();
+	EXPECT_TRUE(cbb.is_auto_compact());
+	cbb&=rhs;
+	EXPECT_EQ(2, cbb.number_of_bitblocks());
+	EXPECT_TRUE(cbb==lax);
+
+	cbb.erase_bit(0);
+	EXPECT_EQ(1, cbb.number_of_bitblocks());
+	cbb.erase_bit(rhs);
+	EXPECT_EQ(0, cbb.number_of_bitblocks());
+	EXPECT_TRUE(cbb.is_empty());
+
+	cbb=bb;															//the mode is copied (off)
+	cbb.set_auto_compact();
+	cbb.erase_bit(bb);
+	EXPECT_EQ(0, cbb.number_of_bitblocks());
+
+	cbb=bb;
+	EXPECT_FALSE(cbb.is_auto_compact());
+	cbb.set_auto_compact();
+	cbb.erase_block(2, rhs);										//removes 500
+	cbb.AND_EQ(0, rhs);
+	EXPECT_EQ(1, cbb.number_of_bitblocks());
+	EXPECT_TRUE(cbb.is_bit(0));
+}
+
+TEST(Sparse, bulk_construction){
+	vector<int> bits;
+	for(int i=5; i<100000; i+=97) bits.push_back(i);
+	bits.push_back(bits.back());										//duplicate
+
+	BitBoardS ref(100000);
+	for(int i=0; i<bits.size(); i++) ref.set_bit(bits[i]);
+
+	BBIntrinS bbs(100000);
+	EXPECT_EQ(0, bbs.init_sorted(bits));
+	EXPECT_TRUE(bbs==ref);
+
+	vector<int> shuffled(bits.rbegin(), bits.rend());
+	swap(shuffled[3], shuffled[500]);
+	BitBoardS bbu(100000);
+	EXPECT_EQ(0, bbu.init_unsorted(shuffled));
+	EXPECT_TRUE(bbu==ref);
+	EXPECT_EQ(-1, bbu.init_sorted(shuffled));							//not sorted
+	EXPECT_TRUE(bbu.is_empty());
+
+	BitBoardS small(100);
+	EXPECT_EQ(-1, small.init_sorted(bits));								//outside population
+
+	BitBoardS nopop;													//population taken from the bits
+	EXPECT_EQ(0, nopop.init_unsorted(shuffled));
+	EXPECT_TRUE(nopop==ref);
+
+	BBIntrin bbn(100000);
+	for(int i=0; i<bits.size(); i++) bbn.set_bit(bits[i]);
+	BitBoardS bbd;
+	bbd.init_dense(bbn);
+	EXPECT_TRUE(bbd==ref);
+	EXPECT_EQ(ref.number_of_bitblocks(), bbd.number_of_bitblocks());
+}
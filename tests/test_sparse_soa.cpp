@@ -0,0 +1,115 @@
+//tests for sparse bit strings with a structure of arrays layout (BitBoardSA)
+
+#include <iostream>
+#include <set>
+
+#include "../bitscan.h"				//bit string library
+#include "google/gtest/gtest.h"
+
+using namespace std;
+
+TEST(SparseSoA, setters_and_getters){
+	BitBoardSA bb(100000);
+	EXPECT_TRUE(bb.is_empty());
+
+	for(int i=99999; i>=0; i-=777) bb.set_bit(i);					//insertion out of order
+	EXPECT_EQ(129, bb.popcn64());
+	EXPECT_TRUE(bb.is_bit(99999));
+	EXPECT_TRUE(bb.is_bit(99999-777*50));
+	EXPECT_FALSE(bb.is_bit(99998));
+	EXPECT_EQ(-1, bb.set_bit(100096));								//outside population
+
+	//block search (binary + linear count)
+	for(int i=0; i<bb.number_of_bitblocks(); i++){
+		EXPECT_EQ(i, bb.lower_pos(bb.get_index(i)));
+		EXPECT_EQ(bb.get_bitboard(i), bb.find_bitboard(bb.get_index(i)));
+	}
+	EXPECT_EQ(bb.number_of_bitblocks(), bb.lower_pos(WDIV(99999)+1));
+	EXPECT_FALSE(bb.find_pos(1).first);
+	EXPECT_EQ(EMPTY_ELEM, bb.find_pos(WDIV(99999)+1).second);
+
+	bb.erase_bit(99999);
+	EXPECT_FALSE(bb.is_bit(99999));
+	int nBB=bb.number_of_bitblocks();
+	bb.shrink_to_fit();												//removes the empty block
+	EXPECT_EQ(nBB-1, bb.number_of_bitblocks());
+}
+
+TEST(SparseSoA, set_operations){
+	BitBoardS ls(10000), rs(10000), res_s;
+	for(int i=0; i<10000; i+=3) ls.set_bit(i);
+	for(int i=0; i<10000; i+=5) rs.set_bit(i);
+	for(int i=5000; i<5100; i++) rs.set_bit(i);
+
+	BitBoardSA lhs(ls), rhs(rs), res;
+	vector<int> v, vs;
+
+	AND(lhs, rhs, res);
+	AND(ls, rs, res_s);
+	res.to_vector(v); res_s.to_vector(vs);
+	EXPECT_EQ(vs, v);
+
+	OR(lhs, rhs, res);
+	OR(ls, rs, res_s);
+	res.to_vector(v); res_s.to_vector(vs);
+	EXPECT_EQ(vs, v);
+
+	ERASE(lhs, rhs, res);
+	ERASE(ls, rs, res_s);
+	res.to_vector(v); res_s.to_vector(vs);
+	EXPECT_EQ(vs, v);
+
+	BitBoardSA bb(lhs);
+	bb&=rhs;
+	AND(lhs, rhs, res);
+	EXPECT_TRUE(bb==res);
+	bb=lhs;
+	bb|=rhs;
+	OR(lhs, rhs, res);
+	EXPECT_TRUE(bb==res);
+
+	EXPECT_FALSE(lhs.is_disjoint(rhs));
+	ERASE(lhs, rhs, res);
+	EXPECT_TRUE(res.is_disjoint(rhs));
+
+	//round trip
+	BitBoardS back;
+	lhs.to_sparse(back);
+	EXPECT_TRUE(back==ls);
+}
+
+TEST(SparseSoA, scanning){
+	BitBoardSA bb(1000);
+	set<int> sol;
+	for(int i=1; i<1000; i+=37){ bb.set_bit(i); sol.insert(i);}
+
+	set<int> res;
+	bb.init_scan(bbo::NON_DESTRUCTIVE);
+	for(int nBit=bb.next_bit(); nBit!=EMPTY_ELEM; nBit=bb.next_bit())
+		res.insert(nBit);
+	EXPECT_EQ(sol, res);
+
+	vector<int> rev;
+	bb.init_scan(bbo::NON_DESTRUCTIVE_REVERSE);
+	for(int nBit=bb.previous_bit(); nBit!=EMPTY_ELEM; nBit=bb.previous_bit())
+		rev.push_back(nBit);
+	EXPECT_TRUE(equal(rev.begin(), rev.end(), sol.rbegin()));
+
+	BitBoardSA bbd(bb);
+	rev.clear();
+	bbd.init_scan(bbo::DESTRUCTIVE_REVERSE);
+	for(int nBit=bbd.previous_bit_del(); nBit!=EMPTY_ELEM; nBit=bbd.previous_bit_del())
+		rev.push_back(nBit);
+	EXPECT_TRUE(equal(rev.begin(), rev.end(), sol.rbegin()));
+	EXPECT_TRUE(bbd.is_empty());
+
+	res.clear();
+	bb.init_scan(bbo::DESTRUCTIVE);
+	for(int nBit=bb.next_bit_del(); nBit!=EMPTY_ELEM; nBit=bb.next_bit_del())
+		res.insert(nBit);
+	EXPECT_EQ(sol, res);
+	EXPECT_TRUE(bb.is_empty());
+
+	BitBoardSA empty(1000);
+	EXPECT_EQ(EMPTY_ELEM, empty.init_scan(bbo::NON_DESTRUCTIVE));
+}
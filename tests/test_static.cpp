@@ -0,0 +1,93 @@
+//tests for bit strings of fixed size (StaticBitBoard)
+
+#include <iostream>
+
+#include "../bitscan.h"				//bit string library
+#include "google/gtest/gtest.h"
+
+using namespace std;
+
+TEST(Static, setters_and_getters){
+	StaticBitBoard<200> bb;
+	EXPECT_EQ(4, bb.number_of_bitblocks());
+	EXPECT_TRUE(bb.is_empty());
+
+	bb.set_bit(0); bb.set_bit(64); bb.set_bit(199);
+	EXPECT_EQ(3, bb.popcn64());
+	EXPECT_EQ(2, bb.popcn64(1));
+	EXPECT_EQ(0, bb.lsbn64());
+	EXPECT_EQ(199, bb.msbn64());
+
+	bb.erase_bit(199);
+	EXPECT_FALSE(bb.is_bit(199));
+	EXPECT_EQ(64, bb.msbn64());
+
+	bb.set_bit();											//bits beyond 199 are not set
+	EXPECT_EQ(200, bb.popcn64());
+	bb.erase_bit();
+	bb.set_bit(60, 130);
+	EXPECT_EQ(71, bb.popcn64());
+	EXPECT_EQ(-1, bb.set_bit(10, 200));
+}
+
+TEST(Static, scanning){
+	vector<int> v;
+	for(int i=0; i<1000; i+=37) v.push_back(i);
+	StaticBitBoard<1000> bb(v);
+
+	//non destructive
+	vector<int> res;
+	bb.init_scan(bbo::NON_DESTRUCTIVE);
+	int nBit;
+	while((nBit=bb.next_bit())!=EMPTY_ELEM)
+		res.push_back(nBit);
+	EXPECT_EQ(v, res);
+
+	//reverse
+	res.clear();
+	bb.init_scan(bbo::NON_DESTRUCTIVE_REVERSE);
+	while((nBit=bb.previous_bit())!=EMPTY_ELEM)
+		res.insert(res.begin(), nBit);
+	EXPECT_EQ(v, res);
+
+	//destructive with a second bit string
+	StaticBitBoard<1000> bb1(bb);
+	res.clear();
+	int nBB=EMPTY_ELEM;
+	bb.init_scan(bbo::DESTRUCTIVE);
+	while((nBit=bb.next_bit_del(nBB, bb1))!=EMPTY_ELEM){
+		EXPECT_EQ(WDIV(nBit), nBB);
+		res.push_back(nBit);
+	}
+	EXPECT_EQ(v, res);
+	EXPECT_TRUE(bb.is_empty());
+	EXPECT_TRUE(bb1.is_empty());
+}
+
+TEST(Static, set_operations){
+	StaticBitBoard<130> lhs, rhs, res;
+	lhs.set_bit(0, 100);
+	rhs.set_bit(50, 129);
+
+	AND(lhs, rhs, res);
+	EXPECT_EQ(51, res.popcn64());
+	EXPECT_EQ(51, lhs.popcount_and(rhs));
+	OR(lhs, rhs, res);
+	EXPECT_EQ(130, res.popcn64());
+	ERASE(lhs, rhs, res);
+	EXPECT_EQ(50, res.popcn64());
+	EXPECT_TRUE(res.is_disjoint(rhs));
+
+	res=lhs;
+	res^=rhs;
+	EXPECT_EQ(79, res.popcn64());
+	res&=lhs;
+	EXPECT_EQ(50, res.popcn64());
+	res|=rhs;
+	EXPECT_EQ(130, res.popcn64());
+
+	vector<int> lv;
+	rhs.to_vector(lv);
+	EXPECT_EQ(80, lv.size());
+	EXPECT_EQ(50, lv.front());
+}
@@ -0,0 +1,136 @@
+//tests for dense bit strings with a hierarchical summary of non-empty blocks (BBSummary)
+
+#include <iostream>
+#include <set>
+
+#include "../bitscan.h"				//bit string library
+#include "google/gtest/gtest.h"
+
+using namespace std;
+
+TEST(Summary, setters_and_getters){
+	BBSummary bbs(1000000);
+	EXPECT_EQ(3, bbs.number_of_levels());
+	EXPECT_TRUE(bbs.is_empty());
+	EXPECT_EQ(EMPTY_ELEM, bbs.next_block(0));
+	EXPECT_EQ(EMPTY_ELEM, bbs.lsbn64());
+
+	bbs.set_bit(10); bbs.set_bit(500000); bbs.set_bit(999999);
+	EXPECT_FALSE(bbs.is_empty());
+	EXPECT_EQ(WDIV(500000), bbs.next_block(1));
+	EXPECT_EQ(WDIV(500000), bbs.previous_block(WDIV(999999)-1));
+	EXPECT_EQ(EMPTY_ELEM, bbs.next_block(WDIV(999999)+1));
+	EXPECT_EQ(10, bbs.lsbn64());
+	EXPECT_EQ(999999, bbs.msbn64());
+
+	//the summary is cleared when the block becomes empty
+	bbs.erase_bit(500000);
+	EXPECT_EQ(WDIV(999999), bbs.next_block(1));
+	bbs.erase_bit(10);
+	bbs.erase_bit(999999);
+	EXPECT_TRUE(bbs.is_empty());
+	for(int l=0; l<bbs.number_of_levels(); l++){
+		for(int i=0; i<bbs.get_level(l).size(); i++)
+			EXPECT_EQ(ZERO, bbs.get_level(l)[i]);
+	}
+
+	//ranges
+	bbs.set_bit(1000, 100000);
+	EXPECT_EQ(99001, bbs.popcn64());
+	EXPECT_EQ(1000, bbs.lsbn64());
+	bbs.erase_bit(1000, 99999);
+	EXPECT_EQ(100000, bbs.lsbn64());
+	EXPECT_EQ(100000, bbs.msbn64());
+}
+
+TEST(Summary, set_operations){
+	BBIntrin bbi(100000);
+	BBSummary bbs(100000);
+	bbs.set_bit(5); bbs.set_bit(70000); bbs.set_bit(99000);
+	bbi.set_bit(70000); bbi.set_bit(99000); bbi.set_bit(30000);
+
+	BBSummary bbc(bbs);
+	bbc&=bbi;
+	EXPECT_EQ(70000, bbc.lsbn64());
+	EXPECT_EQ(2, bbc.popcn64());
+
+	bbc.erase_bit(bbi);
+	EXPECT_TRUE(bbc.is_empty());
+
+	bbc|=bbi;
+	EXPECT_EQ(30000, bbc.lsbn64());
+	bbc^=bbs;
+	EXPECT_EQ(5, bbc.lsbn64());
+	EXPECT_EQ(30000, bbc.msbn64());
+
+	//assignment from a dense bit string rebuilds the summary
+	BBSummary bba(bbi);
+	EXPECT_EQ(30000, bba.lsbn64());
+	EXPECT_EQ(99000, bba.msbn64());
+}
+
+TEST(Summary, scanning){
+	BBSummary bbs(300000);
+	set<int> sol;
+	for(int i=17; i<300000; i+=4999){ bbs.set_bit(i); sol.insert(i);}
+	for(int i=150000; i<150100; i++){ bbs.set_bit(i); sol.insert(i);}
+
+	set<int> res;
+	bbs.init_scan(bbo::NON_DESTRUCTIVE);
+	for(int nBit=bbs.next_bit(); nBit!=EMPTY_ELEM; nBit=bbs.next_bit())
+		res.insert(nBit);
+	EXPECT_EQ(sol, res);
+
+	vector<int> rev;
+	bbs.init_scan(bbo::NON_DESTRUCTIVE_REVERSE);
+	for(int nBit=bbs.previous_bit(); nBit!=EMPTY_ELEM; nBit=bbs.previous_bit())
+		rev.push_back(nBit);
+	EXPECT_EQ(sol.size(), rev.size());
+	EXPECT_TRUE(equal(rev.begin(), rev.end(), sol.rbegin()));
+
+	//through the virtual interface
+	BBSummary bbd(bbs);
+	BBIntrin& ref=bbd;
+	rev.clear();
+	ref.init_scan(bbo::DESTRUCTIVE_REVERSE);
+	for(int nBit=ref.previous_bit_del(); nBit!=EMPTY_ELEM; nBit=ref.previous_bit_del())
+		rev.push_back(nBit);
+	EXPECT_TRUE(equal(rev.begin(), rev.end(), sol.rbegin()));
+	EXPECT_TRUE(bbd.is_empty());
+
+	res.clear();
+	bbs.init_scan(bbo::DESTRUCTIVE);
+	for(int nBit=bbs.next_bit_del(); nBit!=EMPTY_ELEM; nBit=bbs.next_bit_del())
+		res.insert(nBit);
+	EXPECT_EQ(sol, res);
+	EXPECT_TRUE(bbs.is_empty());
+	EXPECT_EQ(ZERO, bbs.get_level(bbs.number_of_levels()-1)[0]);
+}
+
+TEST(Summary, move_semantics){
+	BBSummary bbs(10000);
+	bbs.set_bit(10); bbs.set_bit(9999);
+	const BITBOARD* p=bbs.get_bitstring();
+
+	//construction
+	BBSummary moved(std::move(bbs));
+	EXPECT_EQ(p, moved.get_bitstring());					//no copy
+	EXPECT_EQ(10, moved.lsbn64());
+	EXPECT_EQ(9999, moved.msbn64());
+	EXPECT_EQ(NULL, bbs.get_bitstring());
+	EXPECT_EQ(0, bbs.number_of_levels());
+	EXPECT_TRUE(bbs.is_empty());
+	EXPECT_EQ(EMPTY_ELEM, bbs.lsbn64());
+
+	//assignment
+	BBSummary other(500);
+	other.set_bit(100);
+	other=std::move(moved);
+	EXPECT_EQ(p, other.get_bitstring());
+	EXPECT_EQ(10, other.lsbn64());
+	EXPECT_EQ(NULL, moved.get_bitstring());
+	EXPECT_EQ(0, moved.number_of_levels());
+	EXPECT_TRUE(moved.is_empty());
+	EXPECT_EQ(EMPTY_ELEM, moved.lsbn64());
+	EXPECT_EQ(EMPTY_ELEM, moved.msbn64());
+}